@@ -64,7 +64,8 @@ int parse(string const & filename, map<string, map_entry> & data) {
             for (size_t inx = line.find(" : ", from);
                 inx != string::npos;
                 inx = line.find(" : ", from)) {
-                tokens[ti] = trim(line.substr(from, inx-from));
+                if (ti < 4)
+                    tokens[ti] = trim(line.substr(from, inx-from));
                 from = inx+1;
                 ti++;
             }
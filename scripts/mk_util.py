@@ -110,6 +110,7 @@ GIT_DESCRIBE=False
 SLOW_OPTIMIZE=False
 LOG_SYNC=False
 SINGLE_THREADED=False
+THREAD_CACHE_ALLOC=False
 GUARD_CF=False
 ALWAYS_DYNAMIC_BASE=False
 
@@ -658,6 +659,7 @@ def display_help(exit_code):
         print("  --gprof                       enable gprof")
     print("  --log-sync                    synchronize access to API log files to enable multi-thread API logging.")
     print("  --single-threaded             non-thread-safe build")
+    print("  --thread-cache-alloc          serve small allocations from per-thread free lists")
     print("")
     print("Some influential environment variables:")
     if not IS_WINDOWS:
@@ -682,14 +684,14 @@ def display_help(exit_code):
 def parse_options():
     global VERBOSE, DEBUG_MODE, IS_WINDOWS, VS_X64, ONLY_MAKEFILES, SHOW_CPPS, VS_PROJ, TRACE, VS_PAR, VS_PAR_NUM
     global DOTNET_CORE_ENABLED, DOTNET_KEY_FILE, JAVA_ENABLED, ML_ENABLED, JS_ENABLED, STATIC_LIB, STATIC_BIN, PREFIX, GMP, PYTHON_PACKAGE_DIR, GPROF, GIT_HASH, GIT_DESCRIBE, PYTHON_INSTALL_ENABLED, PYTHON_ENABLED
-    global LINUX_X64, SLOW_OPTIMIZE, LOG_SYNC, SINGLE_THREADED
+    global LINUX_X64, SLOW_OPTIMIZE, LOG_SYNC, SINGLE_THREADED, THREAD_CACHE_ALLOC
     global GUARD_CF, ALWAYS_DYNAMIC_BASE
     try:
         options, remainder = getopt.gnu_getopt(sys.argv[1:],
                                                'b:df:sxhmcvtnp:gj',
                                                ['build=', 'debug', 'silent', 'x64', 'help', 'makefiles', 'showcpp', 'vsproj', 'guardcf',
                                                 'trace', 'dotnet', 'dotnet-key=', 'staticlib', 'prefix=', 'gmp', 'java', 'parallel=', 'gprof', 'js',
-                                                'githash=', 'git-describe', 'x86', 'ml', 'optimize', 'pypkgdir=', 'python', 'staticbin', 'log-sync', 'single-threaded'])
+                                                'githash=', 'git-describe', 'x86', 'ml', 'optimize', 'pypkgdir=', 'python', 'staticbin', 'log-sync', 'single-threaded', 'thread-cache-alloc'])
     except:
         print("ERROR: Invalid command line option")
         display_help(1)
@@ -755,6 +757,8 @@ def parse_options():
             LOG_SYNC = True
         elif opt == '--single-threaded':
             SINGLE_THREADED = True
+        elif opt == '--thread-cache-alloc':
+            THREAD_CACHE_ALLOC = True
         elif opt in ('--python'):
             PYTHON_ENABLED = True
             PYTHON_INSTALL_ENABLED = True
@@ -2396,7 +2400,7 @@ def mk_config():
     if ONLY_MAKEFILES:
         return
     config = open(os.path.join(BUILD_DIR, 'config.mk'), 'w')
-    global CXX, CC, GMP, GUARD_CF, STATIC_BIN, GIT_HASH, CPPFLAGS, CXXFLAGS, LDFLAGS, EXAMP_DEBUG_FLAG, FPMATH_FLAGS, LOG_SYNC, SINGLE_THREADED
+    global CXX, CC, GMP, GUARD_CF, STATIC_BIN, GIT_HASH, CPPFLAGS, CXXFLAGS, LDFLAGS, EXAMP_DEBUG_FLAG, FPMATH_FLAGS, LOG_SYNC, SINGLE_THREADED, THREAD_CACHE_ALLOC
     if IS_WINDOWS:
         config.write(
             'CC=cl\n'
@@ -2420,6 +2424,8 @@ def mk_config():
             extra_opt = '%s /DZ3_LOG_SYNC' % extra_opt
         if SINGLE_THREADED:
             extra_opt = '%s /DSINGLE_THREAD' % extra_opt
+        elif THREAD_CACHE_ALLOC:
+            extra_opt = '%s /DZ3_THREAD_CACHE_ALLOC' % extra_opt
         if GIT_HASH:
             extra_opt = ' %s /D Z3GITHASH=%s' % (extra_opt, GIT_HASH)
         if GUARD_CF:
@@ -2521,6 +2527,8 @@ def mk_config():
             CXXFLAGS = '%s -DZ3_LOG_SYNC' % CXXFLAGS
         if SINGLE_THREADED:
             CXXFLAGS = '%s -DSINGLE_THREAD' % CXXFLAGS
+        elif THREAD_CACHE_ALLOC:
+            CXXFLAGS = '%s -DZ3_THREAD_CACHE_ALLOC' % CXXFLAGS
         if DEBUG_MODE:
             CXXFLAGS     = '%s -g -Wall' % CXXFLAGS
             EXAMP_DEBUG_FLAG = '-g'
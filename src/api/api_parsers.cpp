@@ -16,6 +16,10 @@ Revision History:
 
 --*/
 #include<iostream>
+#include<fstream>
+#include<cstring>
+#include "util/mapped_file.h"
+#include "ast/ast_binary.h"
 #include "api/z3.h"
 #include "api/api_log_macros.h"
 #include "api/api_context.h"
@@ -32,7 +36,8 @@ extern "C" {
     // ---------------
     // Support for SMTLIB2
 
-    Z3_ast_vector parse_smtlib2_stream(bool exec, Z3_context c, std::istream& is,
+    // parse from the stream is if it is not null, otherwise from the buffer [begin, end)
+    Z3_ast_vector parse_smtlib2_input(bool exec, Z3_context c, std::istream* is, char const* begin, char const* end,
                                        unsigned num_sorts,
                                        Z3_symbol const _sort_names[],
                                        Z3_sort const _sorts[],
@@ -89,7 +94,8 @@ extern "C" {
         std::stringstream errstrm;
         ctx->set_regular_stream(errstrm);
         try {
-            if (!parse_smt2_commands(*ctx.get(), is)) {
+            bool ok = is ? parse_smt2_commands(*ctx.get(), *is) : parse_smt2_commands(*ctx.get(), begin, end);
+            if (!ok) {
                 ctx = nullptr;
                 SET_ERROR_CODE(Z3_PARSER_ERROR, errstrm.str());
                 return of_ast_vector(v);
@@ -117,9 +123,7 @@ extern "C" {
                                           Z3_func_decl const decls[]) {
         Z3_TRY;
         LOG_Z3_parse_smtlib2_string(c, str, num_sorts, sort_names, sorts, num_decls, decl_names, decls);
-        std::string s(str);
-        std::istringstream is(s);
-        Z3_ast_vector r = parse_smtlib2_stream(false, c, is, num_sorts, sort_names, sorts, num_decls, decl_names, decls);
+        Z3_ast_vector r = parse_smtlib2_input(false, c, nullptr, str, str + strlen(str), num_sorts, sort_names, sorts, num_decls, decl_names, decls);
         RETURN_Z3(r);
         Z3_CATCH_RETURN(nullptr);
     }
@@ -133,16 +137,48 @@ extern "C" {
                                         Z3_func_decl const decls[]) {
         Z3_TRY;
         LOG_Z3_parse_smtlib2_string(c, file_name, num_sorts, sort_names, sorts, num_decls, decl_names, decls);
+        mapped_file f(file_name, false);
+        if (f.is_open()) {
+            Z3_ast_vector r = parse_smtlib2_input(false, c, nullptr, f.begin(), f.end(), num_sorts, sort_names, sorts, num_decls, decl_names, decls);
+            RETURN_Z3(r);
+        }
+        // input that cannot be mapped, such as a pipe, is streamed
         std::ifstream is(file_name);
         if (!is) {
             SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
             return nullptr;
         }
-        Z3_ast_vector r = parse_smtlib2_stream(false, c, is, num_sorts, sort_names, sorts, num_decls, decl_names, decls);
+        Z3_ast_vector r = parse_smtlib2_input(false, c, &is, nullptr, nullptr, num_sorts, sort_names, sorts, num_decls, decl_names, decls);
         RETURN_Z3(r);
         Z3_CATCH_RETURN(nullptr);
     }
 
+    Z3_ast_vector Z3_API Z3_parse_binary_file(Z3_context c, Z3_string file_name) {
+        Z3_TRY;
+        LOG_Z3_parse_binary_file(c, file_name);
+        RESET_ERROR_CODE();
+        mapped_file f(file_name, true);
+        if (!f.is_open()) {
+            SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
+            return nullptr;
+        }
+        ast_manager& m = mk_c(c)->m();
+        Z3_ast_vector_ref * v = alloc(Z3_ast_vector_ref, *mk_c(c), m);
+        mk_c(c)->save_object(v);
+        ast_ref_vector roots(m);
+        try {
+            read_ast_binary(m, f.begin(), f.end(), roots);
+        }
+        catch (z3_exception& e) {
+            SET_ERROR_CODE(Z3_PARSER_ERROR, e.msg());
+            RETURN_Z3(of_ast_vector(v));
+        }
+        for (ast* a : roots)
+            v->m_ast_vector.push_back(a);
+        RETURN_Z3(of_ast_vector(v));
+        Z3_CATCH_RETURN(nullptr);
+    }
+
     Z3_string Z3_API Z3_eval_smtlib2_string(Z3_context c, Z3_string str) {
         std::stringstream ous;
         Z3_TRY;
@@ -22,7 +22,9 @@ Revision History:
 #include "util/file_path.h"
 #include "util/scoped_timer.h"
 #include "util/file_path.h"
+#include "util/mapped_file.h"
 #include "ast/ast_pp.h"
+#include "ast/ast_binary.h"
 #include "api/z3.h"
 #include "api/api_log_macros.h"
 #include "api/api_context.h"
@@ -236,6 +238,33 @@ extern "C" {
         Z3_CATCH_RETURN(nullptr);
     }
 
+    Z3_solver Z3_API Z3_solver_snapshot(Z3_context c, Z3_solver s) {
+        Z3_TRY;
+        LOG_Z3_solver_snapshot(c, s);
+        RESET_ERROR_CODE();
+        params_ref const& p = to_solver(s)->m_params; 
+        Z3_solver_ref * sr = alloc(Z3_solver_ref, *mk_c(c), nullptr);
+        init_solver(c, s);
+        sr->m_solver = to_solver(s)->m_solver->translate(mk_c(c)->m(), p);
+        sr->m_params = p;
+        sr->m_logic = to_solver(s)->m_logic;
+        mk_c(c)->save_object(sr);
+        Z3_solver r = of_solver(sr);
+        init_solver_log(c, r);
+        RETURN_Z3(r);
+        Z3_CATCH_RETURN(nullptr);
+    }
+
+    void Z3_API Z3_solver_restore(Z3_context c, Z3_solver s, Z3_solver snapshot) {
+        Z3_TRY;
+        LOG_Z3_solver_restore(c, s, snapshot);
+        RESET_ERROR_CODE();
+        init_solver(c, snapshot);
+        to_solver(s)->m_solver = to_solver_ref(snapshot)->translate(mk_c(c)->m(), to_solver(s)->m_params);
+        if (to_solver(s)->m_pp) to_solver(s)->m_pp->reset();
+        Z3_CATCH;
+    }
+
 
     void Z3_API Z3_solver_import_model_converter(Z3_context c, Z3_solver src, Z3_solver dst) {
         Z3_TRY;
@@ -287,6 +316,21 @@ extern "C" {
         }
     }
 
+    static void solver_from_binary(Z3_context c, Z3_solver s, char const* begin, char const* end) {
+        ast_manager& m = mk_c(c)->m();
+        ast_ref_vector roots(m);
+        try {
+            read_ast_binary(m, begin, end, roots);
+        }
+        catch (z3_exception& e) {
+            SET_ERROR_CODE(Z3_PARSER_ERROR, e.msg());
+            return;
+        }
+        for (ast* a : roots) 
+            if (is_expr(a) && m.is_bool(to_expr(a)))
+                to_solver(s)->assert_expr(to_expr(a));
+    }
+
     // DIMACS files start with "p cnf" and number of variables/clauses.
     // This is not legal SMT syntax, so use the DIMACS parser.
     static bool is_dimacs_string(Z3_string c_str) {
@@ -311,16 +355,23 @@ extern "C" {
         Z3_TRY;
         LOG_Z3_solver_from_file(c, s, file_name);
         char const* ext = get_extension(file_name);
-        std::ifstream is(file_name);
+        // binary files are recognized when they can be mapped, other input is streamed
+        mapped_file in(file_name, false);
         init_solver(c, s);
-        if (!is) {
-            SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
-        }
-        else if (ext && (std::string("dimacs") == ext || std::string("cnf") == ext)) {
-            solver_from_dimacs_stream(c, s, is);
+        if (in.is_open() && is_ast_binary(in.begin(), in.end())) {
+            solver_from_binary(c, s, in.begin(), in.end());
         }
         else {
-            solver_from_stream(c, s, is);
+            std::ifstream is(file_name);
+            if (!is) {
+                SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
+            }
+            else if (ext && (std::string("dimacs") == ext || std::string("cnf") == ext)) {
+                solver_from_dimacs_stream(c, s, is);
+            }
+            else {
+                solver_from_stream(c, s, is);
+            }
         }
         Z3_CATCH;
     }
@@ -715,6 +766,25 @@ extern "C" {
         Z3_CATCH_RETURN("");
     }
 
+    void Z3_API Z3_solver_to_binary_file(Z3_context c, Z3_solver s, Z3_string file_name) {
+        Z3_TRY;
+        LOG_Z3_solver_to_binary_file(c, s, file_name);
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        std::ofstream out(file_name, std::ios::out | std::ios::binary);
+        if (!out) {
+            SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
+            return;
+        }
+        expr_ref_vector fmls(mk_c(c)->m());
+        to_solver_ref(s)->get_assertions(fmls);
+        write_ast_binary(out, mk_c(c)->m(), fmls.size(), reinterpret_cast<ast* const*>(fmls.data()));
+        out.close();
+        if (!out) 
+            SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
+        Z3_CATCH;
+    }
+
     Z3_string Z3_API Z3_solver_to_dimacs_string(Z3_context c, Z3_solver s, bool include_names) {
         Z3_TRY;
         LOG_Z3_solver_to_string(c, s);
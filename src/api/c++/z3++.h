@@ -2437,6 +2437,8 @@ namespace z3 {
         void push() { Z3_solver_push(ctx(), m_solver); check_error(); }
         void pop(unsigned n = 1) { Z3_solver_pop(ctx(), m_solver, n); check_error(); }
         void reset() { Z3_solver_reset(ctx(), m_solver); check_error(); }
+        solver snapshot() const { Z3_solver s = Z3_solver_snapshot(ctx(), m_solver); check_error(); return solver(ctx(), s); }
+        void restore(solver const& snapshot) { Z3_solver_restore(ctx(), m_solver, snapshot); check_error(); }
         void add(expr const & e) { assert(e.is_bool()); Z3_solver_assert(ctx(), m_solver, e); check_error(); }
         void add(expr const & e, expr const & p) {
             assert(e.is_bool()); assert(p.is_bool()); assert(p.is_const());
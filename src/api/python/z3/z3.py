@@ -6930,6 +6930,29 @@ class Solver(Z3PPObject):
     def __deepcopy__(self, memo={}):
         return self.translate(self.ctx)
 
+    def snapshot(self):
+        """Return a snapshot of `self`, a solver in the same context that starts from the current state of `self`.
+        Assertions that were already preprocessed and learned clauses are reused.
+
+        >>> x = Int('x')
+        >>> s = Solver()
+        >>> s.add(x > 0)
+        >>> s0 = s.snapshot()
+        >>> s.add(x < 0)
+        >>> s.check()
+        unsat
+        >>> s.restore(s0)
+        >>> s.check()
+        sat
+        """
+        return Solver(Z3_solver_snapshot(self.ctx.ref(), self.solver), self.ctx)
+
+    def restore(self, snapshot):
+        """Replace the assertions and the state of `self` by a copy of the solver `snapshot`."""
+        if z3_debug():
+            _z3_assert(isinstance(snapshot, Solver), "argument must be a Z3 solver")
+        Z3_solver_restore(self.ctx.ref(), self.solver, snapshot.solver)
+
     def sexpr(self):
         """Return a formatted string (in Lisp-like format) with all added constraints. We say the string is in s-expression format.
 
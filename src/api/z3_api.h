@@ -5576,6 +5576,16 @@ extern "C" {
                                         Z3_symbol const decl_names[],
                                         Z3_func_decl const decls[]);
 
+    /**
+       \brief Load the ASTs stored in a file written in Z3's binary format, see #Z3_solver_to_binary_file.
+
+       Sorts, declarations and datatypes used by the ASTs are created in the context \c c,
+       they are shared with ASTs already in \c c.
+
+       def_API('Z3_parse_binary_file', AST_VECTOR, (_in(CONTEXT), _in(STRING)))
+    */
+    Z3_ast_vector Z3_API Z3_parse_binary_file(Z3_context c, Z3_string file_name);
+
 
     /**
        \brief Parse and evaluate and SMT-LIB2 command sequence. The state from a previous call is saved so the next
@@ -6298,10 +6308,47 @@ extern "C" {
     /**
        \brief Copy a solver \c s from the context \c source to the context \c target.
 
+       When \c target is \c source the copy shares the assertions of \c s and
+       reuses the preprocessing that was already performed for them, and clauses
+       learned by the SAT solver are retained. The internal state of the solver
+       is still copied, not shared.
+       The solver \c s must not be inside a scope created by #Z3_solver_push.
+
        def_API('Z3_solver_translate', SOLVER, (_in(CONTEXT), _in(SOLVER), _in(CONTEXT)))
     */
     Z3_solver Z3_API Z3_solver_translate(Z3_context source, Z3_solver s, Z3_context target);
 
+    /**
+       \brief Create a snapshot of the solver \c s in the same context.
+
+       The snapshot is a new solver that starts from the current state of \c s:
+       it shares the assertions of \c s, reuses the preprocessing already performed
+       for them and retains the clauses learned by the SAT solver.
+       A snapshot can be checked and extended like any other solver. Taking several
+       snapshots of one snapshot forks it into independent solvers, and
+       #Z3_solver_restore resets a solver to a snapshot, so that the setup of a common
+       prefix of assertions is paid for once.
+       The solver \c s must not be inside a scope created by #Z3_solver_push.
+
+       \sa Z3_solver_restore
+
+       def_API('Z3_solver_snapshot', SOLVER, (_in(CONTEXT), _in(SOLVER)))
+    */
+    Z3_solver Z3_API Z3_solver_snapshot(Z3_context c, Z3_solver s);
+
+    /**
+       \brief Replace the assertions and the state of the solver \c s by a copy of the
+       solver \c snapshot, which is typically obtained using #Z3_solver_snapshot.
+       The scopes of \c s are discarded and \c snapshot is not modified.
+       The parameters of \c s are kept.
+       The solver \c snapshot must not be inside a scope created by #Z3_solver_push.
+
+       \sa Z3_solver_snapshot
+
+       def_API('Z3_solver_restore', VOID, (_in(CONTEXT), _in(SOLVER), _in(SOLVER)))
+    */
+    void Z3_API Z3_solver_restore(Z3_context c, Z3_solver s, Z3_solver snapshot);
+
     /**
        \brief Ad-hoc method for importing model conversion from solver.
 
@@ -6452,8 +6499,12 @@ extern "C" {
     /**
        \brief load solver assertions from a file.
 
+       Files written by #Z3_solver_to_binary_file are recognized by their contents,
+       other files are parsed as DIMACS (extension \c .cnf or \c .dimacs) or SMT-LIB2.
+
        \sa Z3_solver_from_string
        \sa Z3_solver_to_string
+       \sa Z3_solver_to_binary_file
 
        def_API('Z3_solver_from_file', VOID, (_in(CONTEXT), _in(SOLVER), _in(STRING)))
     */
@@ -6721,6 +6772,19 @@ extern "C" {
     */
     Z3_string Z3_API Z3_solver_to_string(Z3_context c, Z3_solver s);
 
+    /**
+       \brief Save the assertions of a solver to a file in Z3's binary format.
+
+       The file stores each sort, declaration and expression once and can be
+       loaded with #Z3_solver_from_file or #Z3_parse_binary_file without parsing SMT-LIB2 text.
+
+       \sa Z3_solver_from_file
+       \sa Z3_parse_binary_file
+
+       def_API('Z3_solver_to_binary_file', VOID, (_in(CONTEXT), _in(SOLVER), _in(STRING)))
+    */
+    void Z3_API Z3_solver_to_binary_file(Z3_context c, Z3_solver s, Z3_string file_name);
+
     /**
        \brief Convert a solver into a DIMACS formatted string.
        \sa Z3_goal_to_diamcs_string for requirements.
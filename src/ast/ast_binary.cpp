@@ -0,0 +1,890 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    ast_binary.cpp
+
+Abstract:
+
+    Compact binary format for ASTs.
+
+    Numbers are stored as LEB128 varints (signed numbers zig-zag encoded).
+    References to nodes are stored as the distance to the number of
+    nodes read so far, which keeps them small for local sharing.
+
+--*/
+#include <cstring>
+#include <sstream>
+#include "util/map.h"
+#include "util/z3_exception.h"
+#include "ast/ast_binary.h"
+#include "ast/datatype_decl_plugin.h"
+#include "ast/fpa_decl_plugin.h"
+
+namespace {
+
+    char const     g_magic[4] = { 'Z', '3', 'A', 'B' };
+    unsigned const g_version  = 1;
+
+    enum record_kind {
+        R_FAMILY = 1,
+        R_SORT,
+        R_FUNC_DECL,
+        R_FPA_NUMERAL,
+        R_APP,
+        R_VAR,
+        R_QUANTIFIER,
+        R_DATATYPES,
+        R_ROOTS
+    };
+
+    enum param_kind {
+        P_INT,
+        P_AST,
+        P_SYMBOL,
+        P_RATIONAL,
+        P_DOUBLE
+    };
+
+    enum func_decl_flag {
+        F_LEFT_ASSOC       = 1 << 0,
+        F_RIGHT_ASSOC      = 1 << 1,
+        F_FLAT_ASSOCIATIVE = 1 << 2,
+        F_COMMUTATIVE      = 1 << 3,
+        F_CHAINABLE        = 1 << 4,
+        F_PAIRWISE         = 1 << 5,
+        F_INJECTIVE        = 1 << 6,
+        F_IDEMPOTENT       = 1 << 7,
+        F_SKOLEM           = 1 << 8,
+        F_LAMBDA           = 1 << 9
+    };
+
+    class writer {
+        ast_manager &                            m;
+        std::ostream &                           m_out;
+        datatype_util                            m_dt;
+        family_id                                m_fpa_fid;
+        obj_map<ast, unsigned>                   m_ids;
+        u_map<unsigned>                          m_families;
+        ptr_vector<ast>                          m_todo;
+        obj_hashtable<ast>                       m_visited;
+        ptr_vector<ast>                          m_order;
+        unsigned                                 m_num_nodes { 0 };
+        ptr_vector<datatype::def const>          m_datatypes;
+        ptr_addr_hashtable<datatype::def const>  m_datatypes_seen;
+
+        void write_byte(unsigned b) { m_out.put(static_cast<char>(b)); }
+
+        void write_unsigned(uint64_t n) {
+            while (n >= 0x80) {
+                m_out.put(static_cast<char>((n & 0x7f) | 0x80));
+                n >>= 7;
+            }
+            m_out.put(static_cast<char>(n));
+        }
+
+        void write_int(int64_t n) {
+            write_unsigned((static_cast<uint64_t>(n) << 1) ^ static_cast<uint64_t>(n >> 63));
+        }
+
+        void write_string(char const * s, size_t n) {
+            write_unsigned(n);
+            m_out.write(s, n);
+        }
+
+        void write_string(std::string const & s) { write_string(s.c_str(), s.size()); }
+
+        void write_symbol(symbol const & s) {
+            if (s.is_null()) {
+                write_byte(0);
+            }
+            else if (s.is_numerical()) {
+                write_byte(1);
+                write_unsigned(s.get_num());
+            }
+            else {
+                write_byte(2);
+                write_string(s.bare_str(), strlen(s.bare_str()));
+            }
+        }
+
+        void write_rational(rational const & r) {
+            if (r.is_int64()) {
+                write_byte(0);
+                write_int(r.get_int64());
+            }
+            else {
+                write_byte(1);
+                write_string(numerator(r).to_string());
+                write_string(denominator(r).to_string());
+            }
+        }
+
+        void write_ref(unsigned id) {
+            SASSERT(id < m_num_nodes);
+            write_unsigned(m_num_nodes - id);
+        }
+
+        void write_ref(ast * n) { write_ref(m_ids[n]); }
+
+        void write_sort_size(sort_size const & sz) {
+            if (sz.is_finite()) {
+                write_byte(0);
+                write_unsigned(sz.size());
+            }
+            else
+                write_byte(sz.is_very_big() ? 1 : 2);
+        }
+
+        // families are written on first use, so this has to be called before the record that uses it.
+        unsigned family(family_id fid) {
+            if (fid == null_family_id)
+                return 0;
+            unsigned idx = 0;
+            if (m_families.find(fid, idx))
+                return idx;
+            idx = m_families.size() + 1;
+            m_families.insert(fid, idx);
+            write_byte(R_FAMILY);
+            write_symbol(m.get_family_name(fid));
+            return idx;
+        }
+
+        void unsupported(decl * d) {
+            std::ostringstream strm;
+            strm << "binary format does not support the parameters of " << d->get_name();
+            throw default_exception(strm.str());
+        }
+
+        void write_params(decl * d) {
+            unsigned n = d->get_num_parameters();
+            write_unsigned(n);
+            for (unsigned i = 0; i < n; ++i) {
+                parameter const & p = d->get_parameter(i);
+                switch (p.get_kind()) {
+                case parameter::PARAM_INT:
+                    write_byte(P_INT);
+                    write_int(p.get_int());
+                    break;
+                case parameter::PARAM_AST:
+                    write_byte(P_AST);
+                    write_ref(p.get_ast());
+                    break;
+                case parameter::PARAM_SYMBOL:
+                    write_byte(P_SYMBOL);
+                    write_symbol(p.get_symbol());
+                    break;
+                case parameter::PARAM_RATIONAL:
+                    write_byte(P_RATIONAL);
+                    write_rational(p.get_rational());
+                    break;
+                case parameter::PARAM_DOUBLE: {
+                    double d = p.get_double();
+                    char buffer[sizeof(double)];
+                    memcpy(buffer, &d, sizeof(double));
+                    write_byte(P_DOUBLE);
+                    m_out.write(buffer, sizeof(double));
+                    break;
+                }
+                default:
+                    unsupported(d);
+                }
+            }
+        }
+
+        bool is_fpa_numeral(func_decl * f) {
+            return
+                f->get_family_id() == m_fpa_fid &&
+                f->get_decl_kind() == OP_FPA_NUM &&
+                f->get_num_parameters() == 1 &&
+                f->get_parameter(0).is_external();
+        }
+
+        void push(ast * n) {
+            if (!m_visited.contains(n))
+                m_todo.push_back(n);
+        }
+
+        void push_params(decl * d) {
+            for (unsigned i = d->get_num_parameters(); i-- > 0; ) {
+                parameter const & p = d->get_parameter(i);
+                if (p.is_ast())
+                    push(p.get_ast());
+            }
+        }
+
+        void push_children(ast * n) {
+            switch (n->get_kind()) {
+            case AST_SORT:
+                // sorts are written before all other nodes.
+                for (parameter const & p : to_sort(n)->parameters())
+                    if (p.is_ast() && !is_sort(p.get_ast()))
+                        unsupported(to_sort(n));
+                push_params(to_sort(n));
+                break;
+            case AST_FUNC_DECL: {
+                func_decl * f = to_func_decl(n);
+                if (is_fpa_numeral(f))
+                    break;
+                push_params(f);
+                for (sort * s : *f)
+                    push(s);
+                push(f->get_range());
+                break;
+            }
+            case AST_APP:
+                push(to_app(n)->get_decl());
+                for (expr * arg : *to_app(n))
+                    push(arg);
+                break;
+            case AST_VAR:
+                push(to_var(n)->get_sort());
+                break;
+            case AST_QUANTIFIER: {
+                quantifier * q = to_quantifier(n);
+                for (unsigned i = 0; i < q->get_num_decls(); ++i)
+                    push(q->get_decl_sort(i));
+                for (unsigned i = 0; i < q->get_num_children(); ++i)
+                    push(q->get_child(i));
+                break;
+            }
+            default:
+                UNREACHABLE();
+            }
+        }
+
+        void write_sort(sort * s) {
+            sort_info * info = s->get_info();
+            if (!info) {
+                write_byte(R_SORT);
+                write_symbol(s->get_name());
+                write_byte(0);
+                return;
+            }
+            unsigned fam = family(info->get_family_id());
+            write_byte(R_SORT);
+            write_symbol(s->get_name());
+            write_byte(1);
+            write_unsigned(fam);
+            write_int(info->get_decl_kind());
+            write_sort_size(info->get_num_elements());
+            write_byte(info->private_parameters());
+            write_params(s);
+        }
+
+        void write_fpa_numeral(func_decl * f) {
+            fpa_util fu(m);
+            mpf_manager & fm = fu.fm();
+            mpf const & v = fu.plugin().get_value(f->get_parameter(0).get_ext_id());
+            write_byte(R_FPA_NUMERAL);
+            write_unsigned(v.get_ebits());
+            write_unsigned(v.get_sbits());
+            write_byte(fm.sgn(v));
+            write_int(fm.exp(v));
+            write_rational(rational(fm.sig(v)));
+        }
+
+        void write_func_decl(func_decl * f) {
+            if (is_fpa_numeral(f)) {
+                write_fpa_numeral(f);
+                return;
+            }
+            func_decl_info * info = f->get_info();
+            unsigned fam = 0;
+            if (info) {
+                for (unsigned i = 0; i < f->get_num_parameters(); ++i)
+                    if (f->get_parameter(i).is_external())
+                        unsupported(f);
+                fam = family(info->get_family_id());
+            }
+            write_byte(R_FUNC_DECL);
+            write_symbol(f->get_name());
+            write_unsigned(f->get_arity());
+            for (sort * s : *f)
+                write_ref(s);
+            write_ref(f->get_range());
+            if (!info) {
+                write_byte(0);
+                return;
+            }
+            unsigned flags = 0;
+            if (info->is_left_associative()) flags |= F_LEFT_ASSOC;
+            if (info->is_right_associative()) flags |= F_RIGHT_ASSOC;
+            if (info->is_flat_associative()) flags |= F_FLAT_ASSOCIATIVE;
+            if (info->is_commutative()) flags |= F_COMMUTATIVE;
+            if (info->is_chainable()) flags |= F_CHAINABLE;
+            if (info->is_pairwise()) flags |= F_PAIRWISE;
+            if (info->is_injective()) flags |= F_INJECTIVE;
+            if (info->is_idempotent()) flags |= F_IDEMPOTENT;
+            if (info->is_skolem()) flags |= F_SKOLEM;
+            if (info->is_lambda()) flags |= F_LAMBDA;
+            write_byte(1);
+            write_unsigned(fam);
+            write_int(info->get_decl_kind());
+            write_unsigned(flags);
+            write_params(f);
+        }
+
+        void write_app(app * a) {
+            write_byte(R_APP);
+            write_ref(a->get_decl());
+            write_unsigned(a->get_num_args());
+            for (expr * arg : *a)
+                write_ref(arg);
+        }
+
+        void write_var(var * v) {
+            write_byte(R_VAR);
+            write_unsigned(v->get_idx());
+            write_ref(v->get_sort());
+        }
+
+        void write_quantifier(quantifier * q) {
+            write_byte(R_QUANTIFIER);
+            write_byte(q->get_kind());
+            write_unsigned(q->get_num_decls());
+            for (unsigned i = 0; i < q->get_num_decls(); ++i) {
+                write_symbol(q->get_decl_name(i));
+                write_ref(q->get_decl_sort(i));
+            }
+            write_ref(q->get_expr());
+            write_int(q->get_weight());
+            write_symbol(q->get_qid());
+            write_symbol(q->get_skid());
+            write_unsigned(q->get_num_patterns());
+            for (unsigned i = 0; i < q->get_num_patterns(); ++i)
+                write_ref(q->get_pattern(i));
+            write_unsigned(q->get_num_no_patterns());
+            for (unsigned i = 0; i < q->get_num_no_patterns(); ++i)
+                write_ref(q->get_no_pattern(i));
+        }
+
+        void write_node(ast * n) {
+            switch (n->get_kind()) {
+            case AST_SORT:       write_sort(to_sort(n)); break;
+            case AST_FUNC_DECL:  write_func_decl(to_func_decl(n)); break;
+            case AST_APP:        write_app(to_app(n)); break;
+            case AST_VAR:        write_var(to_var(n)); break;
+            case AST_QUANTIFIER: write_quantifier(to_quantifier(n)); break;
+            default:
+                UNREACHABLE();
+            }
+            m_ids.insert(n, m_num_nodes++);
+        }
+
+        // collect the nodes below root in m_order, children first.
+        void process(ast * root) {
+            push(root);
+            while (!m_todo.empty()) {
+                ast * n = m_todo.back();
+                if (m_visited.contains(n)) {
+                    m_todo.pop_back();
+                    continue;
+                }
+                unsigned sz = m_todo.size();
+                push_children(n);
+                if (sz < m_todo.size())
+                    continue;
+                m_todo.pop_back();
+                m_visited.insert(n);
+                m_order.push_back(n);
+            }
+        }
+
+        void collect_datatypes() {
+            // the sorts used in definitions may bring in further datatypes.
+            unsigned head = 0;
+            for (unsigned i = 0; ; ++i) {
+                for (; head < m_order.size(); ++head) {
+                    ast * n = m_order[head];
+                    if (!is_sort(n) || !m_dt.is_datatype(to_sort(n)))
+                        continue;
+                    datatype::def const * d = &m_dt.get_def(to_sort(n));
+                    if (!m_datatypes_seen.contains(d)) {
+                        m_datatypes_seen.insert(d);
+                        m_datatypes.push_back(d);
+                    }
+                }
+                if (i == m_datatypes.size())
+                    break;
+                datatype::def const & d = *m_datatypes[i];
+                for (sort * p : d.params())
+                    process(p);
+                for (datatype::constructor const * c : d)
+                    for (datatype::accessor const * a : *c)
+                        process(a->range());
+            }
+        }
+
+        void write_datatypes() {
+            if (m_datatypes.empty())
+                return;
+            write_byte(R_DATATYPES);
+            write_unsigned(m_datatypes.size());
+            for (datatype::def const * d : m_datatypes) {
+                write_symbol(d->name());
+                write_unsigned(d->params().size());
+                for (sort * p : d->params())
+                    write_ref(p);
+                write_unsigned(d->constructors().size());
+                for (datatype::constructor const * c : *d) {
+                    write_symbol(c->name());
+                    write_symbol(c->recognizer());
+                    write_unsigned(c->accessors().size());
+                    for (datatype::accessor const * a : *c) {
+                        write_symbol(a->name());
+                        write_ref(a->range());
+                    }
+                }
+            }
+        }
+
+    public:
+        writer(ast_manager & m, std::ostream & out): m(m), m_out(out), m_dt(m), m_fpa_fid(m.get_family_id("fpa")) {}
+
+        void operator()(unsigned num_roots, ast * const * roots) {
+            m_out.write(g_magic, sizeof(g_magic));
+            write_unsigned(g_version);
+            for (unsigned i = 0; i < num_roots; ++i)
+                process(roots[i]);
+            collect_datatypes();
+            // sorts come first and datatype definitions right after them, so
+            // that the reader knows the definitions before it creates
+            // constructors, accessors and terms through the datatype theory.
+            for (ast * n : m_order)
+                if (is_sort(n))
+                    write_node(n);
+            write_datatypes();
+            for (ast * n : m_order)
+                if (!is_sort(n))
+                    write_node(n);
+            write_byte(R_ROOTS);
+            write_unsigned(num_roots);
+            for (unsigned i = 0; i < num_roots; ++i)
+                write_ref(roots[i]);
+        }
+    };
+
+    class reader {
+        ast_manager &        m;
+        char const *         m_pos;
+        char const *         m_end;
+        ast_ref_vector       m_nodes;
+        svector<family_id>   m_families;
+        std::string          m_string;
+
+        void error(char const * msg) {
+            throw default_exception(std::string("invalid binary AST file: ") + msg);
+        }
+
+        unsigned read_byte() {
+            if (m_pos == m_end)
+                error("unexpected end of file");
+            return static_cast<unsigned char>(*m_pos++);
+        }
+
+        uint64_t read_uint64() {
+            uint64_t r = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7) {
+                unsigned b = read_byte();
+                r |= static_cast<uint64_t>(b & 0x7f) << shift;
+                if (!(b & 0x80))
+                    return r;
+            }
+            error("number is too large");
+            return 0;
+        }
+
+        unsigned read_unsigned() {
+            uint64_t r = read_uint64();
+            if (r > UINT_MAX)
+                error("number is too large");
+            return static_cast<unsigned>(r);
+        }
+
+        int64_t read_int64() {
+            uint64_t n = read_uint64();
+            return static_cast<int64_t>(n >> 1) ^ -static_cast<int64_t>(n & 1);
+        }
+
+        int read_int() {
+            int64_t r = read_int64();
+            if (r < INT_MIN || r > INT_MAX)
+                error("number is too large");
+            return static_cast<int>(r);
+        }
+
+        std::string const & read_string() {
+            uint64_t n = read_uint64();
+            if (n > static_cast<uint64_t>(m_end - m_pos))
+                error("unexpected end of file");
+            m_string.assign(m_pos, static_cast<size_t>(n));
+            m_pos += n;
+            return m_string;
+        }
+
+        symbol read_symbol() {
+            switch (read_byte()) {
+            case 0: return symbol::null;
+            case 1: return symbol(read_unsigned());
+            case 2: return symbol(read_string());
+            default:
+                error("invalid symbol");
+                return symbol::null;
+            }
+        }
+
+        rational read_rational() {
+            switch (read_byte()) {
+            case 0:
+                return rational(read_int64(), rational::i64());
+            case 1: {
+                rational n(read_string().c_str());
+                rational d(read_string().c_str());
+                if (d.is_zero())
+                    error("invalid rational");
+                return n / d;
+            }
+            default:
+                error("invalid rational");
+                return rational::zero();
+            }
+        }
+
+        sort_size read_sort_size() {
+            switch (read_byte()) {
+            case 0: return sort_size::mk_finite(read_uint64());
+            case 1: return sort_size::mk_very_big();
+            case 2: return sort_size::mk_infinite();
+            default:
+                error("invalid sort size");
+                return sort_size();
+            }
+        }
+
+        family_id read_family() {
+            unsigned idx = read_unsigned();
+            if (idx == 0)
+                return null_family_id;
+            if (idx > m_families.size())
+                error("invalid theory reference");
+            return m_families[idx - 1];
+        }
+
+        ast * read_ref() {
+            uint64_t d = read_uint64();
+            if (d == 0 || d > m_nodes.size())
+                error("invalid node reference");
+            return m_nodes.get(m_nodes.size() - static_cast<unsigned>(d));
+        }
+
+        sort * read_sort_ref() {
+            ast * n = read_ref();
+            if (!is_sort(n))
+                error("sort expected");
+            return to_sort(n);
+        }
+
+        expr * read_expr_ref() {
+            ast * n = read_ref();
+            if (!is_expr(n))
+                error("expression expected");
+            return to_expr(n);
+        }
+
+        void read_params(vector<parameter> & ps) {
+            unsigned n = read_unsigned();
+            for (unsigned i = 0; i < n; ++i) {
+                switch (read_byte()) {
+                case P_INT:
+                    ps.push_back(parameter(read_int()));
+                    break;
+                case P_AST:
+                    ps.push_back(parameter(read_ref()));
+                    break;
+                case P_SYMBOL:
+                    ps.push_back(parameter(read_symbol()));
+                    break;
+                case P_RATIONAL:
+                    ps.push_back(parameter(read_rational()));
+                    break;
+                case P_DOUBLE: {
+                    double d;
+                    if (static_cast<size_t>(m_end - m_pos) < sizeof(double))
+                        error("unexpected end of file");
+                    memcpy(&d, m_pos, sizeof(double));
+                    m_pos += sizeof(double);
+                    ps.push_back(parameter(d));
+                    break;
+                }
+                default:
+                    error("invalid parameter");
+                }
+            }
+        }
+
+        void read_family_record() {
+            symbol name = read_symbol();
+            if (!m.has_plugin(name)) {
+                std::ostringstream strm;
+                strm << "theory " << name << " is not available";
+                error(strm.str().c_str());
+            }
+            m_families.push_back(m.get_family_id(name));
+        }
+
+        void read_sort() {
+            symbol name = read_symbol();
+            if (read_byte() == 0) {
+                m_nodes.push_back(m.mk_uninterpreted_sort(name));
+                return;
+            }
+            family_id fid = read_family();
+            decl_kind k   = read_int();
+            // the size and privacy of theory sorts are determined by the theory.
+            read_sort_size();
+            read_byte();
+            vector<parameter> ps;
+            read_params(ps);
+            if (fid == null_family_id)
+                error("theory sort without a theory");
+            // the kinds of user sorts are numbered per manager, so they are found by name.
+            sort * s = fid == m.get_user_sort_family_id() ?
+                m.mk_uninterpreted_sort(name, ps.size(), ps.data()) :
+                m.mk_sort(fid, k, ps.size(), ps.data());
+            if (!s)
+                error("invalid theory sort");
+            m_nodes.push_back(s);
+        }
+
+        void read_func_decl() {
+            symbol name = read_symbol();
+            unsigned arity = read_unsigned();
+            ptr_buffer<sort> domain;
+            for (unsigned i = 0; i < arity; ++i)
+                domain.push_back(read_sort_ref());
+            sort * range = read_sort_ref();
+            if (read_byte() == 0) {
+                m_nodes.push_back(m.mk_func_decl(name, arity, domain.data(), range));
+                return;
+            }
+            family_id fid = read_family();
+            decl_kind k = read_int();
+            unsigned flags = read_unsigned();
+            vector<parameter> ps;
+            read_params(ps);
+            if (fid != null_family_id) {
+                // theory declarations are checked and created by their theory.
+                func_decl * f = m.mk_func_decl(fid, k, ps.size(), ps.data(), arity, domain.data(), range);
+                if (!f || f->get_range() != range)
+                    error("invalid theory declaration");
+                m_nodes.push_back(f);
+                return;
+            }
+            func_decl_info info(fid, k, ps.size(), ps.data());
+            info.set_left_associative((flags & F_LEFT_ASSOC) != 0);
+            info.set_right_associative((flags & F_RIGHT_ASSOC) != 0);
+            info.set_flat_associative((flags & F_FLAT_ASSOCIATIVE) != 0);
+            info.set_commutative((flags & F_COMMUTATIVE) != 0);
+            info.set_chainable((flags & F_CHAINABLE) != 0);
+            info.set_pairwise((flags & F_PAIRWISE) != 0);
+            info.set_injective((flags & F_INJECTIVE) != 0);
+            info.set_idempotent((flags & F_IDEMPOTENT) != 0);
+            info.set_skolem((flags & F_SKOLEM) != 0);
+            info.set_lambda((flags & F_LAMBDA) != 0);
+            m_nodes.push_back(m.mk_func_decl(name, arity, domain.data(), range, info));
+        }
+
+        void read_fpa_numeral() {
+            if (!m.has_plugin(symbol("fpa")))
+                error("floating point theory is not available");
+            unsigned ebits = read_unsigned();
+            unsigned sbits = read_unsigned();
+            bool sign = read_byte() != 0;
+            int64_t exp = read_int64();
+            rational sig = read_rational();
+            if (ebits < 2 || ebits > 64 || sbits < 3 || !sig.is_int() || sig.is_neg())
+                error("invalid floating point numeral");
+            fpa_util fu(m);
+            scoped_mpf v(fu.fm());
+            fu.fm().set(v, ebits, sbits, sign, exp, sig.to_mpq().numerator());
+            m_nodes.push_back(fu.plugin().mk_numeral_decl(v));
+        }
+
+        void read_app() {
+            ast * f = read_ref();
+            if (!is_func_decl(f))
+                error("function declaration expected");
+            unsigned n = read_unsigned();
+            ptr_buffer<expr> args;
+            for (unsigned i = 0; i < n; ++i)
+                args.push_back(read_expr_ref());
+            m_nodes.push_back(m.mk_app(to_func_decl(f), n, args.data()));
+        }
+
+        void read_var() {
+            unsigned idx = read_unsigned();
+            m_nodes.push_back(m.mk_var(idx, read_sort_ref()));
+        }
+
+        void read_quantifier() {
+            unsigned k = read_byte();
+            if (k > lambda_k)
+                error("invalid quantifier");
+            unsigned num_decls = read_unsigned();
+            svector<symbol> names;
+            ptr_buffer<sort> sorts;
+            for (unsigned i = 0; i < num_decls; ++i) {
+                names.push_back(read_symbol());
+                sorts.push_back(read_sort_ref());
+            }
+            expr * body = read_expr_ref();
+            int weight = read_int();
+            symbol qid = read_symbol();
+            symbol skid = read_symbol();
+            ptr_buffer<expr> patterns, no_patterns;
+            unsigned n = read_unsigned();
+            for (unsigned i = 0; i < n; ++i)
+                patterns.push_back(read_expr_ref());
+            n = read_unsigned();
+            for (unsigned i = 0; i < n; ++i)
+                no_patterns.push_back(read_expr_ref());
+            m_nodes.push_back(m.mk_quantifier(static_cast<quantifier_kind>(k), num_decls, sorts.data(), names.data(), body,
+                                              weight, qid, skid,
+                                              patterns.size(), patterns.data(),
+                                              no_patterns.size(), no_patterns.data()));
+        }
+
+        struct accessor_info {
+            symbol m_name;
+            sort * m_range;
+        };
+
+        struct constructor_info {
+            symbol                 m_name;
+            symbol                 m_recognizer;
+            vector<accessor_info>  m_accessors;
+        };
+
+        struct def_info {
+            symbol                   m_name;
+            ptr_vector<sort>         m_params;
+            vector<constructor_info> m_constructors;
+        };
+
+        void read_datatypes() {
+            datatype_util dt(m);
+            if (!m.has_plugin(dt.get_family_id()))
+                error("datatype theory is not available");
+            vector<def_info> infos;
+            unsigned n = read_unsigned();
+            for (unsigned i = 0; i < n; ++i) {
+                infos.push_back(def_info());
+                def_info & d = infos.back();
+                d.m_name = read_symbol();
+                unsigned num_params = read_unsigned();
+                for (unsigned j = 0; j < num_params; ++j)
+                    d.m_params.push_back(read_sort_ref());
+                unsigned num_cons = read_unsigned();
+                for (unsigned j = 0; j < num_cons; ++j) {
+                    d.m_constructors.push_back(constructor_info());
+                    constructor_info & c = d.m_constructors.back();
+                    c.m_name = read_symbol();
+                    c.m_recognizer = read_symbol();
+                    unsigned num_acc = read_unsigned();
+                    for (unsigned k = 0; k < num_acc; ++k) {
+                        symbol name = read_symbol();
+                        c.m_accessors.push_back(accessor_info({ name, read_sort_ref() }));
+                    }
+                }
+            }
+            // definitions that are already present in the manager are kept.
+            ptr_vector<datatype::def> defs;
+            for (def_info const & d : infos) {
+                if (dt.plugin().is_declared(d.m_name))
+                    continue;
+                ptr_vector<constructor_decl> cs;
+                for (constructor_info const & c : d.m_constructors) {
+                    ptr_vector<accessor_decl> as;
+                    for (accessor_info const & a : c.m_accessors)
+                        as.push_back(mk_accessor_decl(m, a.m_name, type_ref(a.m_range)));
+                    cs.push_back(mk_constructor_decl(c.m_name, c.m_recognizer, as.size(), as.data()));
+                }
+                defs.push_back(mk_datatype_decl(dt, d.m_name, d.m_params.size(), d.m_params.data(), cs.size(), cs.data()));
+            }
+            if (defs.empty())
+                return;
+            sort_ref_vector new_sorts(m);
+            dt.plugin().mk_datatypes(defs.size(), defs.data(), 0, nullptr, new_sorts);
+            // datatype sorts read before their definitions get their size now.
+            for (ast * n : m_nodes)
+                if (is_sort(n) && dt.is_datatype(to_sort(n)))
+                    m.mk_sort(dt.get_family_id(), DATATYPE_SORT, to_sort(n)->get_num_parameters(), to_sort(n)->get_parameters());
+        }
+
+        void read_header() {
+            if (!is_ast_binary(m_pos, m_end))
+                error("missing header");
+            m_pos += sizeof(g_magic);
+            if (read_unsigned() != g_version)
+                error("unsupported version");
+        }
+
+        void read_records(ast_ref_vector & roots) {
+            read_header();
+            while (true) {
+                switch (read_byte()) {
+                case R_FAMILY:      read_family_record(); break;
+                case R_SORT:        read_sort(); break;
+                case R_FUNC_DECL:   read_func_decl(); break;
+                case R_FPA_NUMERAL: read_fpa_numeral(); break;
+                case R_APP:         read_app(); break;
+                case R_VAR:         read_var(); break;
+                case R_QUANTIFIER:  read_quantifier(); break;
+                case R_DATATYPES:   read_datatypes(); break;
+                case R_ROOTS: {
+                    unsigned n = read_unsigned();
+                    for (unsigned i = 0; i < n; ++i)
+                        roots.push_back(read_ref());
+                    if (m_pos != m_end)
+                        error("unexpected data after the end of the file");
+                    return;
+                }
+                default:
+                    error("unknown record");
+                }
+            }
+        }
+
+    public:
+        reader(ast_manager & m, char const * begin, char const * end):
+            m(m), m_pos(begin), m_end(end), m_nodes(m) {}
+
+        void operator()(ast_ref_vector & roots) {
+            try {
+                read_records(roots);
+            }
+            catch (ast_exception & ex) {
+                // theories and the manager reject ill-formed sorts, declarations and terms.
+                error(ex.msg());
+            }
+        }
+    };
+}
+
+void write_ast_binary(std::ostream & out, ast_manager & m, unsigned num_roots, ast * const * roots) {
+    writer w(m, out);
+    w(num_roots, roots);
+}
+
+void read_ast_binary(ast_manager & m, char const * begin, char const * end, ast_ref_vector & roots) {
+    reader r(m, begin, end);
+    r(roots);
+}
+
+bool is_ast_binary(char const * begin, char const * end) {
+    return
+        static_cast<size_t>(end - begin) >= sizeof(g_magic) &&
+        memcmp(begin, g_magic, sizeof(g_magic)) == 0;
+}
@@ -0,0 +1,46 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    ast_binary.h
+
+Abstract:
+
+    Compact binary format for ASTs.
+
+    A file is a header followed by a sequence of records. Sorts,
+    declarations and expressions are stored once each, after their
+    children, and refer to earlier nodes by their (relative) position.
+    Theories are referenced by name and datatype definitions are stored
+    with the file, so it can be loaded into a fresh ast_manager.
+    Loading re-creates the nodes through the manager, which shares them
+    with existing nodes. Theory sorts and declarations are created by
+    their theories, which reject invalid parameters.
+
+    Parameters that are private to a theory (PARAM_EXTERNAL) are only
+    supported for floating point numerals.
+
+--*/
+#pragma once
+
+#include <ostream>
+#include "ast/ast.h"
+
+/**
+   \brief Write the given ASTs and everything they depend on to \c out.
+   \c out should be opened in binary mode.
+*/
+void write_ast_binary(std::ostream & out, ast_manager & m, unsigned num_roots, ast * const * roots);
+
+/**
+   \brief Read the ASTs stored in [begin, end) into \c m and append them to \c roots.
+   Throws default_exception if the contents are not a valid binary AST file.
+*/
+void read_ast_binary(ast_manager & m, char const * begin, char const * end, ast_ref_vector & roots);
+
+/**
+   \brief Return true if [begin, end) starts with the header of a binary AST file.
+*/
+bool is_ast_binary(char const * begin, char const * end);
+
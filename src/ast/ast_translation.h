@@ -41,6 +41,7 @@ class ast_translation {
     unsigned            m_miss_count;
     unsigned            m_insert_count;
     unsigned            m_num_process;
+    bool                m_pin_source;           // false if the caller keeps the source terms alive, so that several threads can translate from the same source
 
     void cache(ast * s, ast * t);
     void collect_decl_extra_children(decl * d);
@@ -53,7 +54,8 @@ class ast_translation {
     ast * process(ast const * n);
 
 public:
-    ast_translation(ast_manager & from, ast_manager & to, bool copy_plugins = true) : m_from_manager(from), m_to_manager(to) {
+    ast_translation(ast_manager & from, ast_manager & to, bool copy_plugins = true, bool pin_source = true) : m_from_manager(from), m_to_manager(to) {
+        m_pin_source = pin_source;
         m_loop_count = 0;
         m_hit_count = 0;
         m_miss_count = 0;
@@ -96,5 +96,191 @@ float cost_evaluator::operator()(expr * f, unsigned num_args, float const * args
     return eval(f);
 }
 
+compiled_cost_function::compiled_cost_function(ast_manager & m):
+    m(m),
+    m_util(m),
+    m_kind(K_NUM),
+    m_num(1.0f),
+    m_var1(0),
+    m_var2(0) {
+}
 
+void compiled_cost_function::set(expr * f) {
+    m_code.reset();
+    m_stack.reset();
+    rational r;
+    expr * x, * y;
+    if (m_util.is_numeral(f, r)) {
+        m_kind = K_NUM;
+        m_num  = static_cast<float>(numerator(r).get_int64())/static_cast<float>(denominator(r).get_int64());
+    }
+    else if (is_var(f)) {
+        m_kind = K_VAR;
+        m_var1 = to_var(f)->get_idx();
+    }
+    else if (m_util.is_add(f, x, y) && is_var(x) && is_var(y)) {
+        m_kind = K_ADD_VARS;
+        m_var1 = to_var(x)->get_idx();
+        m_var2 = to_var(y)->get_idx();
+    }
+    else {
+        m_kind = K_CODE;
+        compile(f);
+        m_stack.resize(m_code.size() + 1);
+    }
+}
 
+/**
+   \brief Emit code that pushes the value of f.
+   The semantics, including the short-circuit evaluation of Boolean
+   connectives, is the one of cost_evaluator.
+*/
+void compiled_cost_function::compile(expr * f) {
+    unsigned sz = is_app(f) ? to_app(f)->get_num_args() : 0;
+    auto arg = [&](unsigned i) { return to_app(f)->get_arg(i); };
+    auto binary = [&](opcode op) {
+        compile(arg(0));
+        compile(arg(1));
+        emit(op);
+    };
+    auto patch = [&](unsigned pc) { m_code[pc].m_arg = m_code.size(); };
+    if (is_var(f)) {
+        emit(PUSH_VAR, to_var(f)->get_idx());
+        return;
+    }
+    if (is_app(f) && to_app(f)->get_family_id() == m.get_basic_family_id()) {
+        switch (to_app(f)->get_decl_kind()) {
+        case OP_TRUE:  emit(PUSH_NUM, 0, 1.0f); return;
+        case OP_FALSE: emit(PUSH_NUM, 0, 0.0f); return;
+        case OP_NOT:   compile(arg(0)); emit(NOT); return;
+        case OP_EQ:    binary(EQ); return;
+        case OP_XOR:   binary(XOR); return;
+        case OP_AND: 
+        case OP_OR: {
+            // and: jump to the result 0 at the first argument that is 0.
+            // or:  jump to the result 1 at the first argument that is not 0.
+            bool is_and = m.is_and(f);
+            unsigned_vector jumps;
+            for (unsigned i = 0; i < sz; ++i) {
+                compile(arg(i));
+                jumps.push_back(m_code.size());
+                emit(is_and ? JMP_IF_ZERO : JMP_IF_NOT_ZERO);
+            }
+            emit(PUSH_NUM, 0, is_and ? 1.0f : 0.0f);
+            unsigned end = m_code.size();
+            emit(JMP);
+            for (unsigned pc : jumps)
+                patch(pc);
+            emit(PUSH_NUM, 0, is_and ? 0.0f : 1.0f);
+            patch(end);
+            return;
+        }
+        case OP_ITE: {
+            compile(arg(0));
+            unsigned else_pc = m_code.size();
+            emit(JMP_IF_ZERO);
+            compile(arg(1));
+            unsigned end = m_code.size();
+            emit(JMP);
+            patch(else_pc);
+            compile(arg(2));
+            patch(end);
+            return;
+        }
+        case OP_IMPLIES: {
+            compile(arg(0));
+            unsigned true_pc = m_code.size();
+            emit(JMP_IF_ZERO);
+            compile(arg(1));
+            emit(TO_BOOL);
+            unsigned end = m_code.size();
+            emit(JMP);
+            patch(true_pc);
+            emit(PUSH_NUM, 0, 1.0f);
+            patch(end);
+            return;
+        }
+        default:
+            break;
+        }
+    }
+    else if (is_app(f) && to_app(f)->get_family_id() == m_util.get_family_id()) {
+        switch (to_app(f)->get_decl_kind()) {
+        case OP_NUM: {
+            rational r = to_app(f)->get_decl()->get_parameter(0).get_rational();
+            emit(PUSH_NUM, 0, static_cast<float>(numerator(r).get_int64())/static_cast<float>(denominator(r).get_int64()));
+            return;
+        }
+        case OP_LE:     binary(LE); return;
+        case OP_GE:     binary(GE); return;
+        case OP_LT:     binary(LT); return;
+        case OP_GT:     binary(GT); return;
+        case OP_ADD:    binary(ADD); return;
+        case OP_SUB:    binary(SUB); return;
+        case OP_MUL:    binary(MUL); return;
+        case OP_DIV:    binary(DIV); return;
+        case OP_UMINUS: compile(arg(0)); emit(UMINUS); return;
+        default:
+            break;
+        }
+    }
+    emit(ERROR);
+}
+
+float compiled_cost_function::var(unsigned idx, unsigned num_args, float const * args) const {
+    if (idx < num_args)
+        return args[num_args - idx - 1];
+    warning_msg("cost function evaluation error");
+    return 1.0f;
+}
+
+float compiled_cost_function::run(unsigned num_args, float const * args) {
+    // m_stack has room for one value per instruction.
+    float * st = m_stack.data();
+    unsigned sp = 0, pc = 0, sz = m_code.size();
+#define BINARY(_op_) st[sp - 2] = _op_; --sp; break
+    while (pc < sz) {
+        instr const & i = m_code[pc++];
+        switch (i.m_op) {
+        case PUSH_NUM: st[sp++] = i.m_num; break;
+        case PUSH_VAR: st[sp++] = var(i.m_arg, num_args, args); break;
+        case NOT:      st[sp - 1] = st[sp - 1] == 0.0f ? 1.0f : 0.0f; break;
+        case TO_BOOL:  st[sp - 1] = st[sp - 1] != 0.0f ? 1.0f : 0.0f; break;
+        case UMINUS:   st[sp - 1] = -st[sp - 1]; break;
+        case EQ:       BINARY(st[sp - 2] == st[sp - 1] ? 1.0f : 0.0f);
+        case XOR:      BINARY(st[sp - 2] != st[sp - 1] ? 1.0f : 0.0f);
+        case LE:       BINARY(st[sp - 2] <= st[sp - 1] ? 1.0f : 0.0f);
+        case GE:       BINARY(st[sp - 2] >= st[sp - 1] ? 1.0f : 0.0f);
+        case LT:       BINARY(st[sp - 2] <  st[sp - 1] ? 1.0f : 0.0f);
+        case GT:       BINARY(st[sp - 2] >  st[sp - 1] ? 1.0f : 0.0f);
+        case ADD:      BINARY(st[sp - 2] + st[sp - 1]);
+        case SUB:      BINARY(st[sp - 2] - st[sp - 1]);
+        case MUL:      BINARY(st[sp - 2] * st[sp - 1]);
+        case DIV:
+            if (st[sp - 1] == 0.0f) {
+                warning_msg("cost function division by zero");
+                st[sp - 2] = 1.0f;
+            }
+            else 
+                st[sp - 2] = st[sp - 2] / st[sp - 1];
+            --sp;
+            break;
+        case JMP:      
+            pc = i.m_arg; 
+            break;
+        case JMP_IF_ZERO:
+            if (st[--sp] == 0.0f) pc = i.m_arg;
+            break;
+        case JMP_IF_NOT_ZERO:
+            if (st[--sp] != 0.0f) pc = i.m_arg;
+            break;
+        case ERROR:
+            warning_msg("cost function evaluation error");
+            st[sp++] = 1.0f;
+            break;
+        }
+    }
+#undef BINARY
+    SASSERT(sp == 1);
+    return st[0];
+}
@@ -38,4 +38,47 @@ public:
     float operator()(expr * f, unsigned num_args, float const * args);
 };
 
+/**
+   \brief Cost function compiled into a small stack program, so that
+   evaluating it does not traverse the AST.
+   Cost functions that are a constant, a single variable, or the sum of
+   two variables, such as the default cost functions, are evaluated directly.
+   Variables follow the same convention as cost_evaluator.
+*/
+class compiled_cost_function {
+    enum opcode {
+        PUSH_NUM, PUSH_VAR, NOT, TO_BOOL, EQ, XOR, LE, GE, LT, GT, 
+        ADD, SUB, UMINUS, MUL, DIV, JMP, JMP_IF_ZERO, JMP_IF_NOT_ZERO, ERROR
+    };
+    enum kind { K_NUM, K_VAR, K_ADD_VARS, K_CODE };
+    struct instr {
+        opcode   m_op;
+        unsigned m_arg;  // variable index or jump target
+        float    m_num;
+        instr(opcode op, unsigned arg = 0, float num = 0.0f): m_op(op), m_arg(arg), m_num(num) {}
+    };
+    ast_manager &   m;
+    arith_util      m_util;
+    kind            m_kind;
+    float           m_num;
+    unsigned        m_var1, m_var2;
+    svector<instr>  m_code;
+    svector<float>  m_stack;
+    void compile(expr * f);
+    void emit(opcode op, unsigned arg = 0, float num = 0.0f) { m_code.push_back(instr(op, arg, num)); }
+    float var(unsigned idx, unsigned num_args, float const * args) const;
+    float run(unsigned num_args, float const * args);
+public:
+    compiled_cost_function(ast_manager & m);
+    void set(expr * f);
+    float operator()(unsigned num_args, float const * args) {
+        switch (m_kind) {
+        case K_NUM:      return m_num;
+        case K_VAR:      return var(m_var1, num_args, args);
+        case K_ADD_VARS: return var(m_var1, num_args, args) + var(m_var2, num_args, args);
+        default:         return run(num_args, args);
+        }
+    }
+};
+
 
@@ -413,7 +413,13 @@ namespace euf {
             m_on_merge(r2, r1);
     }
 
+    /**
+       \brief Remove the congruence roots among the parents of r1 from the table.
+       Their keys are saved in m_table_keys, in the order of the parents, so that
+       reinsert_parents can update them instead of computing them again.
+    */
     void egraph::remove_parents(enode* r1, enode* r2) {
+        m_table_keys.reset();
         for (enode* p : enode_parents(r1)) {
             if (p->is_marked1())
                 continue;
@@ -422,21 +428,26 @@ namespace euf {
                     continue;
                 SASSERT(m_table.contains_ptr(p));
                 p->mark1();
-                erase_from_table(p);
+                m_table_keys.push_back(m_table.erase(p));
                 SASSERT(!m_table.contains_ptr(p));
             }
-            else if (p->is_equality())
+            else if (p->is_equality()) {
                 p->mark1();
+                m_table_keys.push_back(0);
+            }
         }
     }
 
     void egraph::reinsert_parents(enode* r1, enode* r2) {
+        unsigned num_keys = 0;
         for (enode* p : enode_parents(r1)) {
             if (!p->is_marked1())
                 continue;
             p->unmark1();
+            uint64_t key = m_table_keys[num_keys++];
             if (p->merge_enabled()) {
-                auto rc = insert_table(p);
+                auto rc = m_table.reinsert(p, key, r1, r2);
+                p->m_cg = rc.first;
                 enode* p_other = rc.first;
                 SASSERT(m_table.contains_ptr(p) == (p_other == p));
                 if (p_other != p)
@@ -451,6 +462,7 @@ namespace euf {
                 reinsert_equality(p);
             }
         }
+        SASSERT(num_keys == m_table_keys.size());
     }
 
     void egraph::merge_th_eq(enode* n, enode* root) {
@@ -143,6 +143,7 @@ namespace euf {
         ast_manager&           m;
         svector<to_merge>      m_to_merge;
         etable                 m_table;
+        svector<uint64_t>      m_table_keys;   // keys of the parents removed from m_table during merge
         region                 m_region;
         svector<update_record> m_updates;
         unsigned_vector        m_scopes;
@@ -80,7 +80,7 @@ namespace euf {
             return r;
         case 2:
             if (d->is_commutative()) {
-                r = TAG(void*, alloc(comm_table, cg_comm_hash(), cg_comm_eq(m_commutativity)), BINARY_COMM);
+                r = TAG(void*, alloc(comm_table), BINARY_COMM);
                 SASSERT(GET_TAG(r) == BINARY_COMM);
             }
             else {
@@ -213,8 +213,8 @@ namespace euf {
             n_prime = UNTAG(binary_table*, t)->insert_if_not_there(n);
             return enode_bool_pair(n_prime, false);
         case BINARY_COMM:
-            m_commutativity = false;
             n_prime = UNTAG(comm_table*, t)->insert_if_not_there(n);
+            m_commutativity = get_root(n_prime, 0) != get_root(n, 0);
             return enode_bool_pair(n_prime, m_commutativity);
         default:
             n_prime = UNTAG(table*, t)->insert_if_not_there(n);
@@ -222,22 +222,41 @@ namespace euf {
         }
     }
 
-    void etable::erase(enode * n) {
+    uint64_t etable::erase(enode * n) {
         SASSERT(n->num_args() > 0);
         void * t = get_table(n); 
         switch (static_cast<table_kind>(GET_TAG(t))) {
         case UNARY:
-            UNTAG(unary_table*, t)->erase(n);
-            break;
+            return UNTAG(unary_table*, t)->erase(n);
         case BINARY:
-            UNTAG(binary_table*, t)->erase(n);
-            break;
+            return UNTAG(binary_table*, t)->erase(n);
         case BINARY_COMM:
-            UNTAG(comm_table*, t)->erase(n);
-            break;
+            return UNTAG(comm_table*, t)->erase(n);
         default:
             UNTAG(table*, t)->erase(n);
-            break;
+            return 0;
+        }
+    }
+
+    enode_bool_pair etable::reinsert(enode * n, uint64_t key, enode * old_root, enode * new_root) {
+        SASSERT(n->num_args() > 0);
+        enode * n_prime;
+        uint64_t old_id = old_root->get_expr_id();
+        uint64_t new_id = new_root->get_expr_id();
+        void * t = get_table(n); 
+        switch (static_cast<table_kind>(GET_TAG(t))) {
+        case UNARY:
+            n_prime = UNTAG(unary_table*, t)->insert_if_not_there(n, cg_unary_key::replace(key, old_id, new_id));
+            return enode_bool_pair(n_prime, false);
+        case BINARY:
+            n_prime = UNTAG(binary_table*, t)->insert_if_not_there(n, cg_binary_key::replace(key, old_id, new_id));
+            return enode_bool_pair(n_prime, false);
+        case BINARY_COMM:
+            n_prime = UNTAG(comm_table*, t)->insert_if_not_there(n, cg_comm_key::replace(key, old_id, new_id));
+            m_commutativity = get_root(n_prime, 0) != get_root(n, 0);
+            return enode_bool_pair(n_prime, m_commutativity);
+        default:
+            return insert(n);
         }
     }
 
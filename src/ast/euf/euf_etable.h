@@ -19,6 +19,7 @@ Revision History:
 #include "ast/euf/euf_enode.h"
 #include "util/hashtable.h"
 #include "util/chashtable.h"
+#include "util/packed_key_table.h"
 
 namespace euf {
     
@@ -31,80 +32,59 @@ namespace euf {
     class etable {
         static enode* get_root(enode* n, unsigned idx) { return n->get_arg(idx)->get_root(); }
 
-        struct cg_unary_hash {
-            unsigned operator()(enode * n) const {
+        // unary and binary applications are keyed on the ids of their argument roots.
+        // When the root of an argument is merged into another root, replace computes
+        // the new key from the old key.
+        static uint64_t get_root_id(enode* n, unsigned idx) { return get_root(n, idx)->get_expr_id(); }
+
+        struct cg_unary_key {
+            uint64_t operator()(enode * n) const {
                 SASSERT(n->num_args() == 1);
-                return get_root(n, 0)->hash();
+                return get_root_id(n, 0);
             }
-        };
-
-        struct cg_unary_eq {
-
-            bool operator()(enode * n1, enode * n2) const {
-                SASSERT(n1->num_args() == 1);
-                SASSERT(n2->num_args() == 1);
-                SASSERT(n1->get_decl() == n2->get_decl());
-                return get_root(n1, 0) == get_root(n2, 0);
+            static uint64_t replace(uint64_t key, uint64_t old_id, uint64_t new_id) {
+                SASSERT(key == old_id);
+                return new_id;
             }
         };
 
-        typedef chashtable<enode *, cg_unary_hash, cg_unary_eq> unary_table;
+        typedef packed_key_table<enode, cg_unary_key> unary_table;
         
-        struct cg_binary_hash {
-            unsigned operator()(enode * n) const {
+        struct cg_binary_key {
+            uint64_t operator()(enode * n) const {
                 SASSERT(n->num_args() == 2);
-                return combine_hash(get_root(n, 0)->hash(), get_root(n, 1)->hash());
+                return (get_root_id(n, 0) << 32) | get_root_id(n, 1);
             }
-        };
-
-        struct cg_binary_eq {
-            bool operator()(enode * n1, enode * n2) const {
-                SASSERT(n1->num_args() == 2);
-                SASSERT(n2->num_args() == 2);
-                SASSERT(n1->get_decl() == n2->get_decl());
-                return
-                    get_root(n1, 0) == get_root(n2, 0) &&
-                    get_root(n1, 1) == get_root(n2, 1);
+            static uint64_t replace(uint64_t key, uint64_t old_id, uint64_t new_id) {
+                uint64_t id1 = key >> 32;
+                uint64_t id2 = key & 0xFFFFFFFF;
+                SASSERT(id1 == old_id || id2 == old_id);
+                return ((id1 == old_id ? new_id : id1) << 32) | (id2 == old_id ? new_id : id2);
             }
         };
 
-        typedef chashtable<enode*, cg_binary_hash, cg_binary_eq> binary_table;
+        typedef packed_key_table<enode, cg_binary_key> binary_table;
         
-        struct cg_comm_hash {
-            unsigned operator()(enode * n) const {
+        struct cg_comm_key {
+            uint64_t operator()(enode * n) const {
                 SASSERT(n->num_args() == 2);
-                unsigned h1 = get_root(n, 0)->hash();
-                unsigned h2 = get_root(n, 1)->hash(); 
-                if (h1 > h2)
-                    std::swap(h1, h2);
-                return hash_u((h1 << 16) | (h2 & 0xFFFF));
+                uint64_t id1 = get_root_id(n, 0);
+                uint64_t id2 = get_root_id(n, 1);
+                if (id1 > id2)
+                    std::swap(id1, id2);
+                return (id1 << 32) | id2;
             }
-        };
-        
-        struct cg_comm_eq {
-            bool & m_commutativity;
-            cg_comm_eq(bool & c): m_commutativity(c) {}
-            bool operator()(enode * n1, enode * n2) const {
-                SASSERT(n1->num_args() == 2);
-                SASSERT(n2->num_args() == 2);
-
-                SASSERT(n1->get_decl() == n2->get_decl());
-                enode* c1_1 = get_root(n1, 0);  
-                enode* c1_2 = get_root(n1, 1); 
-                enode* c2_1 = get_root(n2, 0); 
-                enode* c2_2 = get_root(n2, 1); 
-                if (c1_1 == c2_1 && c1_2 == c2_2) {
-                    return true;
-                }
-                if (c1_1 == c2_2 && c1_2 == c2_1) {
-                    m_commutativity = true;
-                    return true;
-                }
-                return false;
+            static uint64_t replace(uint64_t key, uint64_t old_id, uint64_t new_id) {
+                key = cg_binary_key::replace(key, old_id, new_id);
+                uint64_t id1 = key >> 32;
+                uint64_t id2 = key & 0xFFFFFFFF;
+                if (id1 > id2)
+                    std::swap(id1, id2);
+                return (id1 << 32) | id2;
             }
         };
 
-        typedef chashtable<enode*, cg_comm_hash, cg_comm_eq> comm_table;
+        typedef packed_key_table<enode, cg_comm_key> comm_table;
 
         struct cg_hash {
             unsigned operator()(enode * n) const;
@@ -165,7 +145,18 @@ namespace euf {
         */
         enode_bool_pair insert(enode * n);
 
-        void erase(enode * n);
+        /**
+           \brief Erase n and return its key, or 0 if n is not a unary or binary application.
+        */
+        uint64_t erase(enode * n);
+
+        /**
+           \brief Insert n after the class of old_root was merged into new_root.
+           key is the value returned by erase(n) before the merge. The key of
+           unary and binary applications is updated from key instead of being
+           computed again from the roots of the arguments.
+        */
+        enode_bool_pair reinsert(enode * n, uint64_t key, enode * old_root, enode * new_root);
 
         bool contains(enode* n) const;
 
@@ -42,6 +42,8 @@ namespace q {
         unsigned m_num_instances_curr_branch; //!< only updated if QI_TRACK_INSTANCES is true
         unsigned m_max_generation; //!< max. generation of an instance
         float    m_max_cost;
+        double   m_sum_cost;
+        unsigned m_num_costs;
 
         friend class quantifier_stat_gen;
 
@@ -124,6 +126,16 @@ namespace q {
         float get_max_cost() const {
             return m_max_cost;
         }
+
+        void update_cost(float c) {
+            update_max_cost(c);
+            m_sum_cost += c;
+            m_num_costs++;
+        }
+
+        float get_avg_cost() const {
+            return m_num_costs == 0 ? 0.0f : static_cast<float>(m_sum_cost / m_num_costs);
+        }
     };
 
     /**
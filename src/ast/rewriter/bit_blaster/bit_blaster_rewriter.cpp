@@ -23,6 +23,7 @@ Notes:
 #include "ast/rewriter/bool_rewriter.h"
 #include "util/ref_util.h"
 #include "ast/ast_smt2_pp.h"
+#include "ast/ast_translation.h"
 
 struct blaster_cfg {
     typedef rational numeral;
@@ -207,6 +208,21 @@ struct blaster_rewriter_cfg : public default_rewriter_cfg {
             newbits.push_back(f);        
     }
 
+    // reuse the bits that src assigned to its constants, so that
+    // constants blasted here again are mapped to the same bits.
+    void copy_translation(blaster_rewriter_cfg const& src, ast_translation& tr) {
+        SASSERT(m_keyval_lim.empty());
+        for (unsigned i = 0; i < src.m_keys.size(); ++i) {
+            func_decl* f = tr(src.m_keys.get(i));
+            expr* r = tr(src.m_values.get(i));
+            m_const2bits.insert(f, r);
+            m_keys.push_back(f);
+            m_values.push_back(r);
+        }
+        for (func_decl* f : src.m_newbits) 
+            m_newbits.push_back(tr(f));
+    }
+
     template<typename V>
     app * mk_mkbv(V const & bits) {
         return m().mk_app(butil().get_family_id(), OP_MKBV, bits.size(), bits.data());
@@ -683,6 +699,7 @@ struct bit_blaster_rewriter::imp : public rewriter_tpl<blaster_rewriter_cfg> {
     void start_rewrite() { m_cfg.start_rewrite(); }
     void end_rewrite(obj_map<func_decl, expr*>& const2bits, ptr_vector<func_decl> & newbits) { m_cfg.end_rewrite(const2bits, newbits); }
     void get_translation(obj_map<func_decl, expr*>& const2bits, ptr_vector<func_decl> & newbits) { m_cfg.get_translation(const2bits, newbits); }
+    void copy_translation(imp const& src, ast_translation& tr) { m_cfg.copy_translation(src.m_cfg, tr); }
     unsigned get_num_scopes() const { return m_cfg.get_num_scopes(); }
 };
 
@@ -742,3 +759,7 @@ void bit_blaster_rewriter::end_rewrite(obj_map<func_decl, expr*>& const2bits, pt
 void bit_blaster_rewriter::get_translation(obj_map<func_decl, expr*>& const2bits, ptr_vector<func_decl> & newbits) {
     m_imp->get_translation(const2bits, newbits);
 }
+
+void bit_blaster_rewriter::copy_translation(bit_blaster_rewriter const& src, ast_translation& tr) {
+    m_imp->copy_translation(*src.m_imp, tr);
+}
@@ -22,6 +22,8 @@ Notes:
 #include "util/obj_hashtable.h"
 #include "util/params.h"
 
+class ast_translation;
+
 class bit_blaster_rewriter {
     struct imp;
     imp * m_imp;
@@ -35,6 +37,7 @@ public:
     void start_rewrite();
     void end_rewrite(obj_map<func_decl, expr*>& const2bits, ptr_vector<func_decl> & newbits);
     void get_translation(obj_map<func_decl, expr*>& const2bits, ptr_vector<func_decl> & newbits);
+    void copy_translation(bit_blaster_rewriter const& src, ast_translation& tr);
     void operator()(expr * e, expr_ref & result, proof_ref & result_proof);
     void push();
     void pop(unsigned num_scopes);
@@ -305,6 +305,12 @@ UNARY_CMD(echo_cmd, "echo", "<string>", "display the given string", CPK_STRING,
     bool smt2c = ctx.params().m_smtlib2_compliant;
     ctx.regular_stream() << (smt2c ? "\"" : "") << arg << (smt2c ? "\"" : "") << std::endl;);
 
+UNARY_CMD(save_binary_cmd, "save-binary", "<string>", "save the asserted formulas to the given file in binary format.", CPK_STRING, char const *,
+          ctx.save_binary(arg); ctx.print_success(););
+
+UNARY_CMD(load_binary_cmd, "load-binary", "<string>", "assert the formulas stored in the given binary file, declaring the symbols they use.", CPK_STRING, char const *,
+          ctx.load_binary(arg); ctx.print_success(););
+
 
 class set_get_option_cmd : public cmd {
 protected:
@@ -897,6 +903,8 @@ void install_ext_basic_cmds(cmd_context & ctx) {
     ctx.insert(alloc(pp_cmd));
     ctx.insert(alloc(get_model_cmd));
     ctx.insert(alloc(echo_cmd));
+    ctx.insert(alloc(save_binary_cmd));
+    ctx.insert(alloc(load_binary_cmd));
     ctx.insert(alloc(labels_cmd));
     ctx.insert(alloc(declare_map_cmd));
     ctx.insert(alloc(builtin_cmd, "reset", nullptr, "reset the shell (all declarations and assertions will be erased)"));
@@ -17,11 +17,13 @@ Notes:
 --*/
 
 #include<signal.h>
+#include<fstream>
 #include "util/tptr.h"
 #include "util/cancel_eh.h"
 #include "util/scoped_ctrl_c.h"
 #include "util/dec_ref_util.h"
 #include "util/scoped_timer.h"
+#include "util/mapped_file.h"
 #include "ast/func_decl_dependencies.h"
 #include "ast/arith_decl_plugin.h"
 #include "ast/bv_decl_plugin.h"
@@ -37,6 +39,7 @@ Notes:
 #include "ast/pp.h"
 #include "ast/ast_smt2_pp.h"
 #include "ast/ast_ll_pp.h"
+#include "ast/ast_binary.h"
 #include "ast/decl_collector.h"
 #include "ast/well_sorted.h"
 #include "ast/for_each_expr.h"
@@ -2136,6 +2139,57 @@ void cmd_context::display_assertions() {
     regular_stream() << ")" << std::endl;
 }
 
+void cmd_context::save_binary(char const * file_name) {
+    std::ofstream out(file_name, std::ios::out | std::ios::binary);
+    if (out.bad() || out.fail())
+        throw cmd_exception(std::string("failed to open file '") + file_name + "'");
+    write_ast_binary(out, m(), m_assertions.size(), reinterpret_cast<ast * const *>(m_assertions.data()));
+    out.close();
+    if (out.bad() || out.fail())
+        throw cmd_exception(std::string("failed to write file '") + file_name + "'");
+}
+
+/**
+   \brief assert the formulas stored in the given binary file.
+   Uninterpreted sorts, functions and datatypes used by the formulas are
+   declared unless they are already declared.
+*/
+void cmd_context::load_binary(char const * file_name) {
+    mapped_file in(file_name, true);
+    if (!in.is_open())
+        throw cmd_exception(std::string("failed to open file '") + file_name + "'");
+    ast_ref_vector roots(m());
+    read_ast_binary(m(), in.begin(), in.end(), roots);
+
+    auto declare = [&](func_decl * f) {
+        func_decls fs;
+        if (!m_func_decls.find(f->get_name(), fs) || !fs.contains(f))
+            insert(f);
+    };
+    datatype_util dt(m());
+    decl_collector decls(m());
+    for (ast * a : roots)
+        decls.visit(a);
+    for (sort * s : decls.get_sorts()) {
+        if (!is_sort_decl(s->get_name()))
+            insert(pm().mk_psort_user_decl(0, s->get_name(), pm().mk_psort_cnst(s)));
+        if (!dt.is_datatype(s))
+            continue;
+        for (func_decl * c : *dt.get_datatype_constructors(s)) {
+            declare(c);
+            declare(dt.get_constructor_recognizer(c));
+            for (func_decl * a : *dt.get_constructor_accessors(c))
+                declare(a);
+        }
+    }
+    for (func_decl * f : decls.get_func_decls())
+        declare(f);
+    for (ast * a : roots) {
+        if (is_expr(a) && m().is_bool(to_expr(a)))
+            assert_expr(to_expr(a));
+    }
+}
+
 bool cmd_context::is_model_available(model_ref& md) const {
     if (produce_models() &&
         has_manager() &&
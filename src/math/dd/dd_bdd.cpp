@@ -43,7 +43,6 @@ namespace dd {
             m_nodes.back().m_index = m_nodes.size()-1;
         }
 
-        m_spare_entry = nullptr;
         m_max_num_bdd_nodes = 1 << 24; // up to 16M nodes
         m_mark_level = 0;
         alloc_free_nodes(1024 + num_vars);
@@ -57,13 +56,6 @@ namespace dd {
     }
 
     bdd_manager::~bdd_manager() {
-        if (m_spare_entry) {
-            m_alloc.deallocate(sizeof(*m_spare_entry), m_spare_entry);
-        }
-        for (auto* e : m_op_cache) {
-            SASSERT(e != m_spare_entry);
-            m_alloc.deallocate(sizeof(*e), e);
-        }
     }
     
     bdd_manager::BDD bdd_manager::apply_const(BDD a, BDD b, bdd_op op) {
@@ -108,22 +100,6 @@ namespace dd {
     bdd bdd_manager::mk_forall(unsigned v, bdd const& b) { return mk_forall(1, &v, b); }
 
 
-    bool bdd_manager::check_result(op_entry*& e1, op_entry const* e2, BDD a, BDD b, BDD c) {
-        if (e1 != e2) {
-            SASSERT(e2->m_result != null_bdd);
-            push_entry(e1);
-            e1 = nullptr;
-            return true;            
-        }
-        else {
-            e1->m_bdd1 = a;
-            e1->m_bdd2 = b;
-            e1->m_op = c;
-            SASSERT(e1->m_result == null_bdd);
-            return false;        
-        }
-    }
-
     bdd_manager::BDD bdd_manager::apply_rec(BDD a, BDD b, bdd_op op) {
         switch (op) {
         case bdd_and_op:
@@ -150,14 +126,12 @@ namespace dd {
         if (is_const(a) && is_const(b)) {
             return m_apply_const[a + 2*b + 4*op];
         }
-        op_entry * e1 = pop_entry(a, b, op);
-        op_entry const* e2 = m_op_cache.insert_if_not_there(e1);
-        if (check_result(e1, e2, a, b, op)) {
-            SASSERT(!m_free_nodes.contains(e2->m_result));
-            return e2->m_result;
+        BDD r;
+        if (m_op_cache.find(a, b, op, r)) {
+            SASSERT(!m_free_nodes.contains(r));
+            return r;
         }
         // SASSERT(well_formed());
-        BDD r;
         if (level(a) == level(b)) {
             push(apply_rec(lo(a), lo(b), op));
             push(apply_rec(hi(a), hi(b), op));
@@ -174,7 +148,7 @@ namespace dd {
             r = make_node(level(b), read(2), read(1));
         }
         pop(2);
-        e1->m_result = r;
+        m_op_cache.insert(a, b, op, r);
         // SASSERT(well_formed());
         SASSERT(!m_free_nodes.contains(r));
         return r;
@@ -192,28 +166,6 @@ namespace dd {
         return m_bdd_stack[m_bdd_stack.size() - index];
     }
 
-    bdd_manager::op_entry* bdd_manager::pop_entry(BDD l, BDD r, BDD op) {
-        op_entry* result = nullptr;
-        if (m_spare_entry) {
-            result = m_spare_entry;
-            m_spare_entry = nullptr;
-            result->m_bdd1 = l;
-            result->m_bdd2 = r;
-            result->m_op = op;
-        }
-        else {
-            void * mem = m_alloc.allocate(sizeof(op_entry));
-            result = new (mem) op_entry(l, r, op);
-        }
-        result->m_result = null_bdd;
-        return result;
-    }
-
-    void bdd_manager::push_entry(op_entry* e) {
-        SASSERT(!m_spare_entry);
-        m_spare_entry = e;
-    }
-
     bdd_manager::BDD bdd_manager::make_node(unsigned lvl, BDD l, BDD h) {
         m_is_new_node = false;
         if (l == h) {
@@ -263,15 +215,12 @@ namespace dd {
 
     void bdd_manager::try_reorder() {
         gc();        
-        for (auto* e : m_op_cache) {
-            m_alloc.deallocate(sizeof(*e), e);
-        }
-        m_op_cache.reset();
         init_reorder();
         for (unsigned i = 0; i < m_var2level.size(); ++i) {
             sift_var(i);
         }
-        SASSERT(m_op_cache.empty());
+        // cached results refer to nodes of the previous order
+        m_op_cache.reset();
         SASSERT(well_formed());
     }
 
@@ -560,15 +509,14 @@ namespace dd {
     bdd_manager::BDD bdd_manager::mk_not_rec(BDD b) {
         if (is_true(b)) return false_bdd;
         if (is_false(b)) return true_bdd;
-        op_entry* e1 = pop_entry(b, b, bdd_not_op);
-        op_entry const* e2 = m_op_cache.insert_if_not_there(e1);
-        if (check_result(e1, e2, b, b, bdd_not_op)) 
-            return e2->m_result;
+        BDD r;
+        if (m_op_cache.find(b, b, bdd_not_op, r))
+            return r;
         push(mk_not_rec(lo(b)));
         push(mk_not_rec(hi(b)));
-        BDD r = make_node(level(b), read(2), read(1));
+        r = make_node(level(b), read(2), read(1));
         pop(2);
-        e1->m_result = r;
+        m_op_cache.insert(b, b, bdd_not_op, r);
         return r;
     }
     
@@ -596,12 +544,11 @@ namespace dd {
         if (is_false(b)) return apply(mk_not_rec(a), c, bdd_and_op);
         if (is_true(c)) return apply(mk_not_rec(a), b, bdd_or_op);
         SASSERT(!is_const(a) && !is_const(b) && !is_const(c));
-        op_entry * e1 = pop_entry(a, b, c);
-        op_entry const* e2 = m_op_cache.insert_if_not_there(e1);
-        if (check_result(e1, e2, a, b, c)) 
-            return e2->m_result;
-        unsigned la = level(a), lb = level(b), lc = level(c);
+        // c is not a constant, so its index is larger than the op codes
         BDD r;
+        if (m_op_cache.find(a, b, c, r))
+            return r;
+        unsigned la = level(a), lb = level(b), lc = level(c);
         BDD a1, b1, c1, a2, b2, c2;
         unsigned lvl = la;
         if (la >= lb && la >= lc) {
@@ -629,7 +576,7 @@ namespace dd {
         push(mk_ite_rec(a2, b2, c2));
         r = make_node(lvl, read(2), read(1));
         pop(2);          
-        e1->m_result = r;
+        m_op_cache.insert(a, b, c, r);
         return r;
     }
 
@@ -665,18 +612,12 @@ namespace dd {
         else {
             BDD a = level2bdd(l);
             bdd_op q_op = op == bdd_and_op ? bdd_and_proj_op : bdd_or_proj_op;
-            op_entry * e1 = pop_entry(a, b, q_op);
-            op_entry const* e2 = m_op_cache.insert_if_not_there(e1);
-            if (check_result(e1, e2, a, b, q_op)) {
-                r = e2->m_result;
-            }
-            else {
-                SASSERT(e1->m_result == null_bdd);
+            if (!m_op_cache.find(a, b, q_op, r)) {
                 push(mk_quant_rec(l, lo(b), op));
                 push(mk_quant_rec(l, hi(b), op));
                 r = make_node(lvl, read(2), read(1));
                 pop(2);
-                e1->m_result = r;
+                m_op_cache.insert(a, b, q_op, r);
             }
         }
         SASSERT(r != UINT_MAX);
@@ -743,6 +684,7 @@ namespace dd {
             m_nodes.back().m_index = m_nodes.size() - 1;
         }
         m_free_nodes.reverse();
+        m_op_cache.reserve(m_nodes.size());
     }
 
     void bdd_manager::gc() {
@@ -784,22 +726,8 @@ namespace dd {
         std::sort(m_free_nodes.begin(), m_free_nodes.end());
         m_free_nodes.reverse();
 
-        ptr_vector<op_entry> to_delete, to_keep;
-        for (auto* e : m_op_cache) {            
-            if (e->m_result != null_bdd) {
-                to_delete.push_back(e);
-            }
-            else {
-                to_keep.push_back(e);
-            }
-        }
+        // freed nodes are reused, so cached results cannot be trusted
         m_op_cache.reset();
-        for (op_entry* e : to_delete) {
-            m_alloc.deallocate(sizeof(*e), e);
-        }
-        for (op_entry* e : to_keep) {
-            m_op_cache.insert(e);
-        }
 
         m_node_table.reset();
         // re-populate node cache
@@ -20,7 +20,7 @@ Revision History:
 
 #include "util/vector.h"
 #include "util/map.h"
-#include "util/small_object_allocator.h"
+#include "math/dd/dd_op_cache.h"
 
 namespace dd {
 
@@ -80,43 +80,14 @@ namespace dd {
         
         typedef hashtable<bdd_node, hash_node, eq_node> node_table;
 
-        struct op_entry {
-            op_entry(BDD l, BDD r, BDD op):
-                m_bdd1(l),
-                m_bdd2(r),
-                m_op(op),
-                m_result(0)
-            {}
-
-            BDD      m_bdd1;
-            BDD      m_bdd2;
-            BDD      m_op;
-            BDD      m_result;
-            unsigned hash() const { return mk_mix(m_bdd1, m_bdd2, m_op); }
-        };
-
-        struct hash_entry {
-            unsigned operator()(op_entry* e) const { return e->hash(); }
-        };
-
-        struct eq_entry {
-            bool operator()(op_entry * a, op_entry * b) const { 
-                return a->m_bdd1 == b->m_bdd2 && a->m_bdd2 == b->m_bdd2 && a->m_op == b->m_op;
-            }
-        };
-
-        typedef ptr_hashtable<op_entry, hash_entry, eq_entry> op_table;
-
         svector<bdd_node>          m_nodes;
-        op_table                   m_op_cache;
+        op_cache                   m_op_cache;
         node_table                 m_node_table;
         unsigned_vector            m_apply_const;
         svector<BDD>               m_bdd_stack;
-        op_entry*                  m_spare_entry;
         svector<BDD>               m_var2bdd;
         unsigned_vector            m_var2level, m_level2var;
         unsigned_vector            m_free_nodes;
-        small_object_allocator     m_alloc;
         mutable svector<unsigned>  m_mark;
         mutable unsigned           m_mark_level;
         mutable svector<double>    m_count;
@@ -146,9 +117,6 @@ namespace dd {
         void pop(unsigned num_scopes);
         BDD read(unsigned index);
 
-        op_entry* pop_entry(BDD l, BDD r, BDD op);
-        void push_entry(op_entry* e);
-        bool check_result(op_entry*& e1, op_entry const* e2, BDD a, BDD b, BDD c);
         
         double count(BDD b, unsigned z);
 
@@ -206,6 +174,7 @@ namespace dd {
         ~bdd_manager();
 
         void set_max_num_nodes(unsigned n) { m_max_num_bdd_nodes = n; }
+        void set_max_op_cache_memory(size_t bytes) { m_op_cache.set_max_memory(bytes); }
 
         bdd mk_var(unsigned i);
         bdd mk_nvar(unsigned i);
@@ -0,0 +1,102 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    dd_op_cache.h
+
+Abstract:
+
+    Operation cache for decision diagram managers.
+
+    The cache is direct mapped: (arg1, arg2, op) is hashed to a single
+    slot and a new entry overwrites the entry stored there. Lookups and
+    updates are a single memory access and the cache does not allocate
+    per entry. It is lossy, so a miss only costs a recomputation.
+
+    The number of slots grows with the number of nodes of the manager
+    up to a maximal size given as a memory budget.
+
+--*/
+#pragma once
+
+#include "util/vector.h"
+#include "util/hash.h"
+
+namespace dd {
+
+    class op_cache {
+        struct entry {
+            unsigned m_arg1;
+            unsigned m_arg2;
+            unsigned m_op;     // 0 if the slot is empty
+            unsigned m_result;
+        };
+
+        svector<entry> m_entries;
+        unsigned       m_mask { 0 };
+        unsigned       m_max_entries { 1 << 20 };
+
+        unsigned slot(unsigned a, unsigned b, unsigned op) const { return mk_mix(a, b, op) & m_mask; }
+
+    public:
+        op_cache() { resize(1 << 10); }
+
+        /**
+           \brief set the maximal memory used by the cache in bytes.
+        */
+        void set_max_memory(size_t bytes) {
+            m_max_entries = 1024;
+            while (2 * m_max_entries * sizeof(entry) <= bytes && m_max_entries < (1u << 30))
+                m_max_entries *= 2;
+            if (m_entries.size() > m_max_entries)
+                resize(m_max_entries);
+        }
+
+        /**
+           \brief make room for about n entries, within the memory budget.
+           The entries are cleared when the cache is resized.
+        */
+        void reserve(unsigned n) {
+            if (n <= m_entries.size() || m_entries.size() >= m_max_entries)
+                return;
+            unsigned sz = m_entries.size();
+            while (sz < n && sz < m_max_entries)
+                sz *= 2;
+            resize(sz);
+        }
+
+        void resize(unsigned sz) {
+            SASSERT((sz & (sz - 1)) == 0);
+            m_entries.reset();
+            m_entries.resize(sz, entry{ 0, 0, 0, 0 });
+            m_mask = sz - 1;
+        }
+
+        void reset() {
+            for (entry & e : m_entries)
+                e.m_op = 0;
+        }
+
+        bool find(unsigned a, unsigned b, unsigned op, unsigned & r) const {
+            SASSERT(op != 0);
+            entry const & e = m_entries[slot(a, b, op)];
+            if (e.m_op != op || e.m_arg1 != a || e.m_arg2 != b)
+                return false;
+            r = e.m_result;
+            return true;
+        }
+
+        void insert(unsigned a, unsigned b, unsigned op, unsigned r) {
+            SASSERT(op != 0);
+            entry & e = m_entries[slot(a, b, op)];
+            e.m_arg1 = a;
+            e.m_arg2 = b;
+            e.m_op = op;
+            e.m_result = r;
+        }
+
+        unsigned size() const { return m_entries.size(); }
+    };
+
+}
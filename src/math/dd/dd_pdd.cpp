@@ -24,7 +24,6 @@ Revision History:
 namespace dd {
 
     pdd_manager::pdd_manager(unsigned num_vars, semantics s, unsigned power_of_2) {
-        m_spare_entry = nullptr;
         m_max_num_nodes = 1 << 24; // up to 16M nodes
         m_mark_level = 0;
         m_dmark_level = 0;
@@ -41,15 +40,10 @@ namespace dd {
     }
 
     pdd_manager::~pdd_manager() {
-        if (m_spare_entry) {
-            m_alloc.deallocate(sizeof(*m_spare_entry), m_spare_entry);
-            m_spare_entry = nullptr;
-        }
-        reset_op_cache();
     }
 
     void pdd_manager::reset(unsigned_vector const& level2var) {
-        reset_op_cache();
+        m_op_cache.reset();
         m_node_table.reset();
         m_nodes.reset();
         m_free_nodes.reset();
@@ -89,14 +83,6 @@ namespace dd {
         }
     }
 
-    void pdd_manager::reset_op_cache() {
-        for (auto* e : m_op_cache) {
-            SASSERT(e != m_spare_entry);
-            m_alloc.deallocate(sizeof(*e), e);
-        }
-        m_op_cache.reset();
-    }
-
     pdd pdd_manager::add(pdd const& a, pdd const& b) { return pdd(apply(a.root, b.root, pdd_add_op), this); }
     pdd pdd_manager::sub(pdd const& a, pdd const& b) { return pdd(apply(a.root, b.root, pdd_sub_op), this); }
     pdd pdd_manager::mul(pdd const& a, pdd const& b) { return pdd(apply(a.root, b.root, pdd_mul_op), this); }
@@ -193,22 +179,6 @@ namespace dd {
         return null_pdd;
     }
 
-    bool pdd_manager::check_result(op_entry*& e1, op_entry const* e2, PDD a, PDD b, PDD c) {
-        if (e1 != e2) {
-            SASSERT(e2->m_result != null_pdd);
-            push_entry(e1);
-            e1 = nullptr;
-            return true;            
-        }
-        else {
-            e1->m_pdd1 = a;
-            e1->m_pdd2 = b;
-            e1->m_op = c;
-            SASSERT(e1->m_result == null_pdd);
-            return false;        
-        }
-    }
-
     pdd_manager::PDD pdd_manager::apply_rec(PDD p, PDD q, pdd_op op) {        
         switch (op) {
         case pdd_sub_op:
@@ -250,13 +220,11 @@ namespace dd {
             break;
         }
 
-        op_entry * e1 = pop_entry(p, q, op);
-        op_entry const* e2 = m_op_cache.insert_if_not_there(e1);
-        if (check_result(e1, e2, p, q, op)) {
-            SASSERT(!m_free_nodes.contains(e2->m_result));
-            return e2->m_result;
-        }
         PDD r;
+        if (m_op_cache.find(p, q, op, r)) {
+            SASSERT(!m_free_nodes.contains(r));
+            return r;
+        }
         unsigned level_p = level(p), level_q = level(q);
         unsigned npop = 2;
                 
@@ -400,7 +368,7 @@ namespace dd {
             break;
         }
         pop(npop);
-        e1->m_result = r;        
+        m_op_cache.insert(p, q, op, r);
         SASSERT(!m_free_nodes.contains(r));
         return r;
     }
@@ -430,15 +398,14 @@ namespace dd {
         SASSERT(m_semantics != mod2_e);
         if (is_zero(a)) return zero_pdd;
         if (is_val(a)) return imk_val(-val(a));
-        op_entry* e1 = pop_entry(a, a, pdd_minus_op);
-        op_entry const* e2 = m_op_cache.insert_if_not_there(e1);
-        if (check_result(e1, e2, a, a, pdd_minus_op)) 
-            return e2->m_result;
+        PDD r;
+        if (m_op_cache.find(a, a, pdd_minus_op, r))
+            return r;
         push(minus_rec(lo(a)));
         push(minus_rec(hi(a)));
-        PDD r = make_node(level(a), read(2), read(1));
+        r = make_node(level(a), read(2), read(1));
         pop(2);
-        e1->m_result = r;
+        m_op_cache.insert(a, a, pdd_minus_op, r);
         return r;
     }
 
@@ -800,28 +767,6 @@ namespace dd {
         return m_pdd_stack[m_pdd_stack.size() - index];
     }
 
-    pdd_manager::op_entry* pdd_manager::pop_entry(PDD l, PDD r, PDD op) {
-        op_entry* result = nullptr;
-        if (m_spare_entry) {
-            result = m_spare_entry;
-            m_spare_entry = nullptr;
-            result->m_pdd1 = l;
-            result->m_pdd2 = r;
-            result->m_op = op;
-        }
-        else {
-            void * mem = m_alloc.allocate(sizeof(op_entry));
-            result = new (mem) op_entry(l, r, op);
-        }
-        result->m_result = null_pdd;
-        return result;
-    }
-
-    void pdd_manager::push_entry(op_entry* e) {
-        SASSERT(!m_spare_entry);
-        m_spare_entry = e;
-    }
-
     pdd_manager::PDD pdd_manager::imk_val(rational const& r) {
         if (r.is_zero()) 
             return zero_pdd;
@@ -913,8 +858,6 @@ namespace dd {
 
     void pdd_manager::try_gc() {
         gc();        
-        reset_op_cache();
-        SASSERT(m_op_cache.empty());
         SASSERT(well_formed());
     }
 
@@ -928,6 +871,31 @@ namespace dd {
         }
     }
 
+    pdd pdd_manager::translate(pdd const& p) {
+        if (&p.m == this)
+            return p;
+        u_map<unsigned> cache;
+        vector<pdd> results;
+        return translate(p.m, p.root, cache, results);
+    }
+
+    pdd pdd_manager::translate(pdd_manager const& src, PDD p, u_map<unsigned>& cache, vector<pdd>& results) {
+        unsigned idx;
+        if (cache.find(p, idx))
+            return results[idx];
+        pdd r(*this);
+        if (src.is_val(p))
+            r = mk_val(src.val(p));
+        else {
+            pdd h = translate(src, src.hi(p), cache, results);
+            pdd l = translate(src, src.lo(p), cache, results);
+            r = mk_var(src.var(p)) * h + l;
+        }
+        cache.insert(p, results.size());
+        results.push_back(r);
+        return r;
+    }
+
     pdd pdd_manager::mk_var(unsigned i) {
         reserve_var(i);
         return pdd(m_var2pdd[i], this);        
@@ -1087,6 +1055,7 @@ namespace dd {
         std::sort(m_free_nodes.begin(), m_free_nodes.end());
         m_free_nodes.reverse();
         init_dmark();
+        m_op_cache.reserve(m_nodes.size());
     }
 
     bool pdd_manager::is_reachable(PDD p) {
@@ -1150,22 +1119,8 @@ namespace dd {
         std::sort(m_free_nodes.begin(), m_free_nodes.end());
         m_free_nodes.reverse();
 
-        ptr_vector<op_entry> to_delete, to_keep;
-        for (auto* e : m_op_cache) {            
-            if (e->m_result != null_pdd) {
-                to_delete.push_back(e);
-            }
-            else {
-                to_keep.push_back(e);
-            }
-        }
+        // freed nodes are reused, so cached results cannot be trusted
         m_op_cache.reset();
-        for (op_entry* e : to_delete) {
-            m_alloc.deallocate(sizeof(*e), e);
-        }
-        for (op_entry* e : to_keep) {
-            m_op_cache.insert(e);
-        }
 
         m_node_table.reset();
         // re-populate node cache
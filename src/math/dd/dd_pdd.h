@@ -32,7 +32,7 @@ Author:
 
 #include "util/vector.h"
 #include "util/map.h"
-#include "util/small_object_allocator.h"
+#include "math/dd/dd_op_cache.h"
 #include "util/rational.h"
 
 namespace dd {
@@ -113,44 +113,15 @@ namespace dd {
 
         typedef map<rational, const_info, rational::hash_proc, rational::eq_proc> mpq_table;
 
-        struct op_entry {
-            op_entry(PDD l, PDD r, PDD op):
-                m_pdd1(l),
-                m_pdd2(r),
-                m_op(op),
-                m_result(0)
-            {}
-
-            PDD      m_pdd1;
-            PDD      m_pdd2;
-            PDD      m_op;
-            PDD      m_result;
-            unsigned hash() const { return mk_mix(m_pdd1, m_pdd2, m_op); }
-        };
-
-        struct hash_entry {
-            unsigned operator()(op_entry* e) const { return e->hash(); }
-        };
-
-        struct eq_entry {
-            bool operator()(op_entry * a, op_entry * b) const { 
-                return a->m_pdd1 == b->m_pdd2 && a->m_pdd2 == b->m_pdd2 && a->m_op == b->m_op;
-            }
-        };
-
-        typedef ptr_hashtable<op_entry, hash_entry, eq_entry> op_table;
-
         svector<node>              m_nodes;
         vector<rational>           m_values;
-        op_table                   m_op_cache;
+        op_cache                   m_op_cache;
         node_table                 m_node_table;
         mpq_table                  m_mpq_table;
         svector<PDD>               m_pdd_stack;
-        op_entry*                  m_spare_entry;
         svector<PDD>               m_var2pdd;
         unsigned_vector            m_var2level, m_level2var;
         unsigned_vector            m_free_nodes;
-        small_object_allocator     m_alloc;
         mutable svector<unsigned>  m_mark;
         mutable unsigned           m_mark_level;
         mutable svector<PDD>       m_todo;
@@ -166,7 +137,6 @@ namespace dd {
         rational                   m_mod2N;
         unsigned                   m_power_of_2 { 0 };
 
-        void reset_op_cache();
         void init_nodes(unsigned_vector const& l2v);
         void init_vars(unsigned_vector const& l2v);
 
@@ -191,9 +161,6 @@ namespace dd {
         void pop(unsigned num_scopes);
         PDD read(unsigned index);
 
-        op_entry* pop_entry(PDD l, PDD r, PDD op);
-        void push_entry(op_entry* e);
-        bool check_result(op_entry*& e1, op_entry const* e2, PDD a, PDD b, PDD c);
         
         void alloc_free_nodes(unsigned n);
         void init_mark();
@@ -231,6 +198,8 @@ namespace dd {
 
         bool var_is_leaf(PDD p, unsigned v);
 
+        pdd translate(pdd_manager const& src, PDD p, u_map<unsigned>& cache, vector<pdd>& results);
+
         bool is_reachable(PDD p);
         void compute_reachable(bool_vector& reachable);
         void try_gc();
@@ -265,6 +234,7 @@ namespace dd {
 
         void reset(unsigned_vector const& level2var);
         void set_max_num_nodes(unsigned n) { m_max_num_nodes = n; }
+        void set_max_op_cache_memory(size_t bytes) { m_op_cache.set_max_memory(bytes); }
         unsigned_vector const& get_level2var() const { return m_level2var; }
 
         pdd mk_var(unsigned i);
@@ -311,6 +281,11 @@ namespace dd {
 
         unsigned_vector const& free_vars(pdd const& p);
 
+        // copy a polynomial owned by another manager into this manager.
+        // The other manager is only read, so several managers can translate
+        // from the same source concurrently as long as the source is not modified.
+        pdd translate(pdd const& p);
+
         std::ostream& display(std::ostream& out);
         std::ostream& display(std::ostream& out, pdd const& b);
 
@@ -65,11 +65,28 @@ public :
 
 private:
 
+    // The sums of the maximal and minimal contributions of the monoids
+    // are accumulated in the same pass that looks for unlimited monoids,
+    // as long as there is no such monoid in the respective direction.
     void analyze() {
+        m_total_max.reset();
+        m_total_min.reset();
+        m_strict_max = m_strict_min = 0;
         for (const auto & c : m_row) {
             if ((m_column_of_l == -2) && (m_column_of_u == -2))
                 return;
             analyze_bound_on_var_on_coeff(c.var(), c.coeff());
+            bool str;
+            if (m_column_of_u == -1) {
+                m_total_max -= monoid_max(c.coeff(), c.var(), str);
+                if (str)
+                    m_strict_max++;
+            }
+            if (m_column_of_l == -1) {
+                m_total_min -= monoid_min(c.coeff(), c.var(), str);
+                if (str)
+                    m_strict_min++;
+            }
         }
         if (m_column_of_u >= 0)
             limit_monoid_u_from_below();
@@ -163,22 +180,14 @@ private:
         return a * (is_neg(a) ? ub(j).x : lb(j).x);
     }
     
-    mpq m_total, m_bound;
+    mpq m_total_max, m_total_min, m_bound;
+    int m_strict_max, m_strict_min;
     void limit_all_monoids_from_above() {
-        int strict = 0;
-        m_total.reset();
-        lp_assert(is_zero(m_total));
-        for (const auto& p : m_row) {
-            bool str;
-            m_total -= monoid_min(p.coeff(), p.var(), str);
-            if (str)
-                strict++;
-        }
-        
+        int strict = m_strict_min;
         for (const auto &p : m_row) {
             bool str;
             bool a_is_pos = is_pos(p.coeff());
-            m_bound = m_total;
+            m_bound = m_total_min;
             m_bound /= p.coeff();
             m_bound += monoid_min_no_mult(a_is_pos, p.var(), str);
             if (a_is_pos) {
@@ -191,20 +200,11 @@ private:
     }
 
     void limit_all_monoids_from_below() {
-        int strict = 0;
-        m_total.reset();
-        lp_assert(is_zero(m_total));
-        for (const auto &p : m_row) {
-            bool str;
-            m_total -= monoid_max(p.coeff(), p.var(), str);
-            if (str)
-                strict++;
-        }
-
+        int strict = m_strict_max;
         for (const auto& p : m_row) {
             bool str;
             bool a_is_pos = is_pos(p.coeff());
-            m_bound = m_total;
+            m_bound = m_total_max;
             m_bound /= p.coeff();
             m_bound += monoid_max_no_mult(a_is_pos, p.var(), str);
             bool astrict = strict - static_cast<int>(str) > 0; 
@@ -54,6 +54,7 @@ public:
     vector<unsigned> m_d_basis;
     vector<unsigned> m_d_nbasis;
     vector<int> m_d_heading;
+    unsigned m_d_presolved_rows { 0 }; // number of rows at the last presolve in doubles
 
 
     lp_primal_core_solver<mpq, numeric_pair<mpq>> m_r_solver; // solver in rational numbers
@@ -111,6 +112,10 @@ public:
 
     void prefix_d();
 
+    void init_double_tableau();
+
+    bool presolve_tableau_with_doubles();
+
     unsigned m_m() const { return m_r_A.row_count();  }
 
     unsigned m_n() const { return m_r_A.column_count(); }
@@ -231,6 +236,16 @@ public:
         return settings().simplex_strategy() == simplex_strategy_enum::lu;
     }
 
+    // The presolve in doubles copies the whole tableau, so it is only worth it
+    // on a cold start: rows were added or removed since the last presolve and
+    // many basic columns are infeasible. Warm starts after a few bound changes
+    // are left to the rational solver.
+    bool need_to_presolve_tableau_with_doubles() const {
+        return m_r_solver.m_look_for_feasible_solution_only && settings().presolve_with_doubles() &&
+            settings().use_tableau_rows() && !is_tiny() &&
+            m_m() != m_d_presolved_rows && 8 * m_r_solver.inf_set_size() >= m_m();
+    }
+
     template <typename L>
     bool is_zero_vector(const vector<L> & b) {
         for (const L & m: b)
@@ -273,7 +288,7 @@ public:
             case column_type::boxed:
                 if (x > m_r_solver.m_upper_bounds[j]) {
                     delta = m_r_solver.m_upper_bounds[j] - x;
-                    x += m_r_solver.m_upper_bounds[j];
+                    x = m_r_solver.m_upper_bounds[j];
                 } else {
                     delta = m_r_solver.m_lower_bounds[j] - x;
                     x = m_r_solver.m_lower_bounds[j];
@@ -93,6 +93,90 @@ void lar_core_solver::prefix_d() {
     m_d_solver.resize_inf_set(m_d_solver.m_n());
 }
 
+/**
+   \brief Copy the rational tableau, bounds and solution to the double solver.
+   Strict bounds are approximated by a small delta, as in get_bounds_for_double_solver.
+*/
+void lar_core_solver::init_double_tableau() {
+    unsigned m = m_m(), n = m_n();
+    m_d_A.clear();
+    m_d_A.init_empty_matrix(m, n);
+    m_d_A.init_vector_of_row_offsets();
+    for (unsigned i = 0; i < m; i++)
+        for (const auto & c : m_r_A.m_rows[i])
+            m_d_A.add_new_element(i, c.var(), c.coeff().get_double());
+    m_d_basis = m_r_basis;
+    m_d_nbasis = m_r_nbasis;
+    m_d_heading = m_r_heading;
+    get_bounds_for_double_solver();
+    double delta = find_delta_for_strict_boxed_bounds().get_double();
+    if (delta > 0.000001)
+        delta = 0.000001;
+    m_d_x.resize(n);
+    for (unsigned j : m_d_nbasis)
+        m_d_x[j] = m_r_x[j].x.get_double() + delta * m_r_x[j].y.get_double();
+    // recompute the basic values from the rows to keep A*x = 0 in doubles
+    for (unsigned i = 0; i < m; i++) {
+        unsigned bj = m_d_basis[i];
+        double v = 0;
+        for (const auto & c : m_d_A.m_rows[i])
+            if (c.var() != bj)
+                v -= c.coeff() * m_d_x[c.var()];
+        m_d_x[bj] = v;
+    }
+    prefix_d();
+    m_d_solver.m_rows_nz.resize(m, 0);
+    m_d_solver.m_columns_nz.resize(n, 0);
+    m_d_solver.init_inf_set();
+}
+
+/**
+   \brief Find a feasible basis with the tableau in doubles, move the
+   rational tableau to that basis, and put the rational non-basic columns
+   at the bounds chosen by the double solver. The rational solver then
+   certifies the basis: it needs no pivots if the basis is feasible in
+   rationals too, and otherwise it continues from there.
+   Return true if the basis is certified.
+*/
+bool lar_core_solver::presolve_tableau_with_doubles() {
+    ++settings().stats().m_double_presolves;
+    m_d_presolved_rows = m_m();
+    init_double_tableau();
+    {
+        // do not let the double solver cycle for long
+        flet<unsigned> _max_iters(settings().max_total_number_of_iterations,
+                                  m_d_solver.total_iterations() + 10 * (m_m() + 100));
+        m_d_solver.m_look_for_feasible_solution_only = true;
+        m_d_solver.set_status(lp_status::UNKNOWN);
+        m_d_solver.start_tracing_basis_changes();
+        m_d_solver.solve_with_tableau();
+        m_d_solver.stop_tracing_basis_changes();
+    }
+    TRACE("lar_solver", tout << "double presolve: " << m_d_solver.get_status() << ", changes " << m_d_solver.m_trace_of_basis_change_vector.size() / 2 << "\n";);
+    switch (m_d_solver.get_status()) {
+    case lp_status::FEASIBLE:
+    case lp_status::OPTIMAL:
+    case lp_status::INFEASIBLE:
+        break;
+    default:
+        return false;
+    }
+    lar_solution_signature signature;
+    extract_signature_from_lp_core_solver(m_d_solver, signature);
+    // a failed pivot is rolled back and the remaining basis changes are skipped
+    catch_up_in_lu_tableau(m_d_solver.m_trace_of_basis_change_vector, m_d_solver.m_basis_heading);
+    // columns that left the rational basis can be out of their bounds
+    for (unsigned j : m_r_nbasis)
+        if (!m_r_solver.column_is_feasible(j))
+            signature[j] = not_at_bound;
+    prepare_solver_x_with_signature_tableau(signature);
+    lp_assert(m_r_solver.non_basic_columns_are_set_correctly());
+    if (!m_r_solver.current_x_is_feasible())
+        return false;
+    ++settings().stats().m_double_certified;
+    return true;
+}
+
 void lar_core_solver::fill_not_improvable_zero_sum_from_inf_row() {
     CASSERT("A_off", m_r_solver.A_mult_x_is_off() == false);
     unsigned bj = m_r_basis[m_r_solver.m_inf_row_index_for_tableau];
@@ -172,6 +256,8 @@ void lar_core_solver::solve() {
             if (snapped)
                 m_r_solver.solve_Ax_eq_b();
         }
+        if (need_to_presolve_tableau_with_doubles())
+            presolve_tableau_with_doubles();
         if (m_r_solver.m_look_for_feasible_solution_only) //todo : should it be set?
             m_r_solver.find_feasible_solution();
         else {
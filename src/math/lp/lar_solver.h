@@ -360,8 +360,25 @@ public:
     template <typename T>
     void propagate_bounds_for_touched_rows(lp_bound_propagator<T> & bp) {
         SASSERT(use_tableau());
-        for (unsigned i : m_rows_with_changed_bounds) {
-            calculate_implied_bounds_for_row(i, bp);
+        stopwatch sw;
+        sw.start();
+        propagate_bounds_for_touched_rows_core(bp);
+        sw.stop();
+        settings().stats().m_bprop_time += sw.get_seconds();
+    }
+    // Analyze at most bprop_max_rows() of the touched rows. The rows
+    // that are not analyzed stay touched and are handled in the next round.
+    template <typename T>
+    void propagate_bounds_for_touched_rows_core(lp_bound_propagator<T> & bp) {
+        unsigned sz = m_rows_with_changed_bounds.size();
+        unsigned n = sz;
+        if (settings().bprop_max_rows() > 0 && n > settings().bprop_max_rows())
+            n = settings().bprop_max_rows();
+        settings().stats().m_bprop_rounds++;
+        settings().stats().m_bprop_rows += n;
+        settings().stats().m_bprop_deferred_rows += sz - n;
+        for (unsigned k = 0; k < n; ++k) {
+            calculate_implied_bounds_for_row(m_rows_with_changed_bounds[k], bp);
             if (settings().get_cancel_flag())
                 return;
         }
@@ -370,13 +387,20 @@ public:
         // and add fixed columns this way
         if (settings().cheap_eqs()) {
             bp.clear_for_eq();
-            for (unsigned i : m_rows_with_changed_bounds) {
-                calculate_cheap_eqs_for_row(i, bp);
+            for (unsigned k = 0; k < n; ++k) {
+                calculate_cheap_eqs_for_row(m_rows_with_changed_bounds[k], bp);
                 if (settings().get_cancel_flag())
                     return;
             }
         }
-        m_rows_with_changed_bounds.clear();
+        if (n == sz)
+            m_rows_with_changed_bounds.clear();
+        else {
+            // erasing position k moves the last element to k,
+            // so going down keeps the rows that were not analyzed.
+            for (unsigned k = n; k-- > 0; )
+                m_rows_with_changed_bounds.erase(m_rows_with_changed_bounds[k]);
+        }
     }
     template <typename T>
     void calculate_cheap_eqs_for_row(unsigned i, lp_bound_propagator<T> & bp) {
@@ -32,5 +32,7 @@ void lp::lp_settings::updt_params(params_ref const& _p) {
     m_print_external_var_name = p.arith_print_ext_var_names();
     report_frequency = p.arith_rep_freq();
     m_simplex_strategy = static_cast<lp::simplex_strategy_enum>(p.arith_simplex_strategy());
+    m_presolve_with_doubles = p.arith_presolve_with_doubles();
+    m_bprop_max_rows = p.arith_bprop_max_rows();
     m_nlsat_delay = p.arith_nl_delay();
 }
@@ -126,6 +126,12 @@ struct statistics {
     unsigned m_grobner_calls;
     unsigned m_grobner_conflicts;
     unsigned m_cheap_eqs;
+    unsigned m_double_presolves;
+    unsigned m_double_certified;
+    unsigned m_bprop_rounds;
+    unsigned m_bprop_rows;
+    unsigned m_bprop_deferred_rows;
+    double   m_bprop_time;
     statistics() { reset(); }
     void reset() { memset(this, 0, sizeof(*this)); }
     void collect_statistics(::statistics& st) const {
@@ -146,6 +152,12 @@ struct statistics {
         st.update("arith-grobner-calls", m_grobner_calls);
         st.update("arith-grobner-conflicts", m_grobner_conflicts);
         st.update("arith-cheap-eqs", m_cheap_eqs);
+        st.update("arith-double-presolves", m_double_presolves);
+        st.update("arith-double-certified", m_double_certified);
+        st.update("arith-bprop-rounds", m_bprop_rounds);
+        st.update("arith-bprop-rows", m_bprop_rows);
+        st.update("arith-bprop-deferred-rows", m_bprop_deferred_rows);
+        st.update("arith-bprop-time", m_bprop_time);
 
     }
 };
@@ -241,8 +253,13 @@ private:
     bool             m_enable_hnf { true };
     bool             m_print_external_var_name { false };
     bool             m_cheap_eqs { false };
+    bool             m_presolve_with_doubles { false };
+    unsigned         m_bprop_max_rows { 0 };
 public:
     bool print_external_var_name() const { return m_print_external_var_name; }
+    bool presolve_with_doubles() const { return m_presolve_with_doubles; }
+    bool& presolve_with_doubles() { return m_presolve_with_doubles; }
+    unsigned bprop_max_rows() const { return m_bprop_max_rows; }
     bool cheap_eqs() const { return m_cheap_eqs;}
     unsigned hnf_cut_period() const { return m_hnf_cut_period; }
     void set_hnf_cut_period(unsigned period) { m_hnf_cut_period = period;  }
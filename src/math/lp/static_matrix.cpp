@@ -29,6 +29,7 @@ Revision History:
 #include "math/lp/scaler.h"
 #include "math/lp/lar_solver.h"
 namespace lp {
+template void static_matrix<double, double>::add_new_element(unsigned int, unsigned int, double const&);
 template void static_matrix<double, double>::add_columns_at_the_end(unsigned int);
 template void static_matrix<double, double>::clear();
 #ifdef Z3DEBUG
@@ -46,6 +47,7 @@ template double static_matrix<double, double>::get_min_abs_in_column(unsigned in
 template double static_matrix<double, double>::get_min_abs_in_row(unsigned int) const;
 template void static_matrix<double, double>::init_empty_matrix(unsigned int, unsigned int);
 template void static_matrix<double, double>::init_row_columns(unsigned int, unsigned int);
+template void static_matrix<double, double>::init_vector_of_row_offsets();
 template static_matrix<double, double>::ref & static_matrix<double, double>::ref::operator=(double const&);
 template void static_matrix<double, double>::set(unsigned int, unsigned int, double const&);
 template static_matrix<double, double>::static_matrix(unsigned int, unsigned int);
@@ -25,7 +25,34 @@ namespace lp {
 // each assignment for this matrix should be issued only once!!!
 
 inline void addmul(double& r, double a, double b) { r += a*b; }
-inline void addmul(mpq& r, mpq const& a, mpq const& b) { r.addmul(a, b); }
+
+// Most tableau coefficients of integer programs are small integers.
+// Pivot them with 64-bit arithmetic when the operands are small enough
+// for the result to fit and use rational arithmetic otherwise.
+// |a|, |b| < 2^31 and |r| < 2^62 keep a * b + r within int64.
+inline bool is_small_int64(mpq const& v, int64_t bound) {
+    if (!v.is_int64())
+        return false;
+    int64_t n = v.get_int64();
+    return -bound < n && n < bound;
+}
+
+inline void addmul(mpq& r, mpq const& a, mpq const& b) {
+    int64_t const factor_bound = int64_t(1) << 31;
+    if (is_small_int64(a, factor_bound) && is_small_int64(b, factor_bound) && is_small_int64(r, int64_t(1) << 62))
+        r.set_int64(a.get_int64() * b.get_int64() + r.get_int64());
+    else
+        r.addmul(a, b);
+}
+
+inline double mul(double a, double b) { return a * b; }
+
+inline mpq mul(mpq const& a, mpq const& b) {
+    int64_t const factor_bound = int64_t(1) << 31;
+    if (is_small_int64(a, factor_bound) && is_small_int64(b, factor_bound))
+        return mpq(a.get_int64() * b.get_int64(), mpq::i64());
+    return a * b;
+}
 
 template <typename T, typename X>
 void  static_matrix<T, X>::init_row_columns(unsigned m, unsigned n) {
@@ -61,7 +88,7 @@ template <typename T, typename X> bool static_matrix<T, X>::pivot_row_to_row_giv
         lp_assert(!is_zero(iv.coeff()));
         int j_offs = m_vector_of_row_offsets[j];
         if (j_offs == -1) { // it is a new element
-            T alv = alpha * iv.coeff();
+            T alv = mul(alpha, iv.coeff());
             add_new_element(ii, j, alv);
         }
         else {
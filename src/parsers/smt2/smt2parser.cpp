@@ -3010,11 +3010,10 @@ namespace smt2 {
             parse_ext_cmd(line, pos);
         }
 
-    public:
-        parser(cmd_context & ctx, std::istream & is, bool interactive, params_ref const & p, char const * filename=nullptr):
+        parser(cmd_context & ctx, std::istream * is, char const * begin, char const * end, bool interactive, params_ref const & p, char const * filename):
             m_ctx(ctx),
             m_params(p),
-            m_scanner(ctx, is, interactive),
+            m_scanner(is ? scanner(ctx, *is, interactive) : scanner(ctx, begin, end)),
             m_curr(scanner::NULL_TOKEN),
             m_curr_cmd(nullptr),
             m_num_bindings(0),
@@ -3065,6 +3064,15 @@ namespace smt2 {
             updt_params();
         }
 
+    public:
+        parser(cmd_context & ctx, std::istream & is, bool interactive, params_ref const & p, char const * filename=nullptr):
+            parser(ctx, &is, nullptr, nullptr, interactive, p, filename) {
+        }
+
+        parser(cmd_context & ctx, char const * begin, char const * end, params_ref const & p, char const * filename=nullptr):
+            parser(ctx, nullptr, begin, end, false, p, filename) {
+        }
+
         ~parser() {
             reset_stack();
         }
@@ -3188,6 +3196,11 @@ bool parse_smt2_commands(cmd_context & ctx, std::istream & is, bool interactive,
     return p();
 }
 
+bool parse_smt2_commands(cmd_context & ctx, char const * begin, char const * end, params_ref const & ps, char const * filename) {
+    smt2::parser p(ctx, begin, end, ps, filename);
+    return p();
+}
+
 sexpr_ref parse_sexpr(cmd_context& ctx, std::istream& is, params_ref const& ps, char const* filename) {
     smt2::parser p(ctx, is, false, ps, filename);
     return p.parse_sexpr_ref();
@@ -22,5 +22,7 @@ Revision History:
 
 bool parse_smt2_commands(cmd_context & ctx, std::istream & is, bool interactive = false, params_ref const & p = params_ref(), char const * filename = nullptr);
 
+bool parse_smt2_commands(cmd_context & ctx, char const * begin, char const * end, params_ref const & p = params_ref(), char const * filename = nullptr);
+
 sexpr_ref parse_sexpr(cmd_context& ctx, std::istream& is, params_ref const& ps, char const* filename);
 
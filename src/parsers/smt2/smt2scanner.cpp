@@ -16,6 +16,7 @@ Author:
 Revision History:
 
 --*/
+#include <cstring>
 #include "parsers/smt2/smt2scanner.h"
 #include "parsers/util/parser_params.hpp"
 
@@ -26,30 +27,48 @@ namespace smt2 {
             m_cache.push_back(m_curr);
         if (m_at_eof)
             throw scanner_exception("unexpected end of file");
-        if (m_interactive) {
-            m_curr = m_stream.get();
-            if (m_stream.eof())
+        if (m_bpos < m_bend) {
+            m_curr = *m_bpos;
+            m_bpos++;
+        }
+        else if (m_interactive) {
+            m_curr = m_stream->get();
+            if (m_stream->eof())
                 m_at_eof = true;
         }
-        else if (m_bpos < m_bend) {
-            m_curr = m_buffer[m_bpos];
-            m_bpos++;
+        else if (!m_stream) {
+            m_at_eof = true;
         }
         else {
-            m_stream.read(m_buffer, SCANNER_BUFFER_SIZE);
-            m_bend = static_cast<unsigned>(m_stream.gcount());
-            m_bpos = 0;
+            m_stream->read(m_buffer, SCANNER_BUFFER_SIZE);
+            m_bpos = m_buffer;
+            m_bend = m_buffer + m_stream->gcount();
             if (m_bpos == m_bend) {
                 m_at_eof = true;
             }
             else {
-                m_curr = m_buffer[m_bpos];
+                m_curr = *m_bpos;
                 m_bpos++;
             }
         }
         m_spos++;
     }
 
+    /**
+       \brief same as calling next() until p becomes the current character.
+       p must be an unread buffered character, and lines are not counted.
+    */
+    void scanner::advance_to(char const* p) {
+        SASSERT(m_bpos <= p && p < m_bend);
+        if (m_cache_input) {
+            m_cache.push_back(m_curr);
+            m_cache.append(static_cast<unsigned>(p - m_bpos), m_bpos);
+        }
+        m_spos += static_cast<int>(p - m_bpos) + 1;
+        m_curr = *p;
+        m_bpos = p + 1;
+    }
+
     void scanner::read_comment() {
         SASSERT(curr() == ';');
         next();
@@ -62,6 +81,13 @@ namespace smt2 {
                 next();
                 return;
             }
+            if (m_bpos < m_bend) {
+                // skip to the end of the line within the buffered characters.
+                char const* p = static_cast<char const*>(memchr(m_bpos, '\n', m_bend - m_bpos));
+                advance_to(p ? p : m_bend - 1);
+                if (p)
+                    continue;
+            }
             next();
         }
     }
@@ -115,9 +141,20 @@ namespace smt2 {
     scanner::token scanner::read_symbol_core() {
         while (!m_at_eof) {
             char c = curr();
-            signed char n = m_normalized[static_cast<unsigned char>(c)];
-            if (n == 'a' || n == '0' || n == '-') {
+            if (is_symbol_char(c)) {
                 m_string.push_back(c);
+                // consume the buffered rest of the symbol at once.
+                char const* q = m_bpos;
+                while (q < m_bend && is_symbol_char(*q))
+                    ++q;
+                if (q > m_bpos) {
+                    m_string.append(static_cast<unsigned>(q - m_bpos), m_bpos);
+                    if (q < m_bend) {
+                        advance_to(q);
+                        continue;
+                    }
+                    advance_to(q - 1);
+                }
                 next();
             }
             else {
@@ -145,17 +182,31 @@ namespace smt2 {
 
     scanner::token scanner::read_number() {
         SASSERT('0' <= curr() && curr() <= '9');
+        // digits are accumulated in machine words and folded into m_number 
+        // in chunks of at most 18 digits.
         rational q(1);
-        m_number = rational(curr() - '0');
+        uint64_t chunk = curr() - '0', scale = 10, q_scale = 1;
+        m_number.reset();
         next();
         bool is_float = false;
+        auto flush = [&]() {
+            m_number = rational(scale, rational::ui64()) * m_number + rational(chunk, rational::ui64());
+            if (q_scale > 1)
+                q *= rational(q_scale, rational::ui64());
+            chunk = 0;
+            scale = 1;
+            q_scale = 1;
+        };
 
         while (!m_at_eof) {
             char c = curr();
             if ('0' <= c && c <= '9') {
-                m_number = rational(10)*m_number + rational(c - '0');
+                if (scale >= 100000000000000000ull)
+                    flush();
+                chunk = 10 * chunk + (c - '0');
+                scale *= 10;
                 if (is_float)
-                    q *= rational(10);
+                    q_scale *= 10;
                 next();
             }
             else if (c == '.') {
@@ -168,6 +219,7 @@ namespace smt2 {
                 break;
             }
         }
+        flush();
         if (is_float)
             m_number /= q;
         TRACE("scanner", tout << "new number: " << m_number << "\n";);
@@ -279,11 +331,30 @@ namespace smt2 {
         m_line(1),
         m_pos(0),
         m_bv_size(UINT_MAX),
-        m_bpos(0),
-        m_bend(0),
-        m_stream(stream),
+        m_bpos(m_buffer),
+        m_bend(m_buffer),
+        m_stream(&stream),
         m_cache_input(false) {
+        init();
+    }
+
+    scanner::scanner(cmd_context & ctx, char const* begin, char const* end) :
+        ctx(ctx),
+        m_interactive(false),
+        m_spos(0),
+        m_curr(0), 
+        m_at_eof(false),
+        m_line(1),
+        m_pos(0),
+        m_bv_size(UINT_MAX),
+        m_bpos(begin),
+        m_bend(end),
+        m_stream(nullptr),
+        m_cache_input(false) {
+        init();
+    }
 
+    void scanner::init() {
 
         for (int i = 0; i < 256; ++i) {
             m_normalized[i] = (signed char) i;
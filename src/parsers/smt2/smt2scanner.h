@@ -46,10 +46,11 @@ namespace smt2 {
         signed char        m_normalized[256];
 #define SCANNER_BUFFER_SIZE 1024
         char               m_buffer[SCANNER_BUFFER_SIZE];
-        unsigned           m_bpos;
-        unsigned           m_bend;
+        // unread characters; they point into m_buffer or into the in-memory input.
+        char const*        m_bpos;
+        char const*        m_bend;
         svector<char>      m_string;
-        std::istream&      m_stream;
+        std::istream*      m_stream;
         
         bool               m_cache_input;
         svector<char>      m_cache;
@@ -59,6 +60,12 @@ namespace smt2 {
         char curr() const { return m_curr; }
         void new_line() { m_line++; m_spos = 0; }
         void next();
+        void advance_to(char const* p);
+        bool is_symbol_char(char c) const { 
+            signed char n = m_normalized[static_cast<unsigned char>(c)];
+            return n == 'a' || n == '0' || n == '-';
+        }
+        void init();
         
     public:
         
@@ -76,6 +83,12 @@ namespace smt2 {
         };
         
         scanner(cmd_context & ctx, std::istream& stream, bool interactive = false);
+
+        /**
+           \brief scan the characters in [begin, end) directly, e.g., from a memory mapped file.
+           The range must remain valid while the scanner is in use.
+        */
+        scanner(cmd_context & ctx, char const* begin, char const* end);
         
         ~scanner() {}    
         
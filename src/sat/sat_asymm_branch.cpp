@@ -28,7 +28,8 @@ namespace sat {
     asymm_branch::asymm_branch(solver & _s, params_ref const & p):
         s(_s),
         m_params(p),
-        m_counter(0) {
+        m_counter(0),
+        m_vivify_counter(0) {
         updt_params(p);
         reset_statistics();
         m_calls = 0;
@@ -39,6 +40,10 @@ namespace sat {
         bool operator()(clause * c1, clause * c2) const { return c1->size() > c2->size(); }
     };
 
+    struct clause_glue_lt {
+        bool operator()(clause * c1, clause * c2) const { return c1->glue() < c2->glue(); }
+    };
+
     struct asymm_branch::report {
         asymm_branch & m_asymm_branch;
         stopwatch      m_watch;
@@ -158,7 +163,7 @@ namespace sat {
         ++m_calls;
         if (m_calls <= m_asymm_branch_delay)
             return;
-        if (!m_asymm_branch && !m_asymm_branch_all && !m_asymm_branch_sampled)
+        if (!m_asymm_branch && !m_asymm_branch_all && !m_asymm_branch_sampled && !m_vivify)
             return;
         s.propagate(false); // must propagate, since it uses s.push()
         if (s.m_inconsistent)
@@ -194,6 +199,8 @@ namespace sat {
             }
             m_touch_index = s.m_touch_index;
         }
+        if (m_vivify && !s.inconsistent())
+            vivify();
 
         s.m_phase = saved_phase;
         m_asymm_branch_limit *= 2;
@@ -421,6 +428,97 @@ namespace sat {
         }
     }
 
+    /**
+       \brief vivify learned clauses, best glue first, and then irredundant clauses.
+    */
+    void asymm_branch::vivify() {
+        unsigned vivified0 = m_vivified, elim0 = m_elim_literals;
+        stopwatch sw;
+        sw.start();
+        m_vivify_counter = m_vivify_limit;
+        std::stable_sort(s.m_learned.begin(), s.m_learned.end(), clause_glue_lt());
+        vivify(s.m_learned);
+        vivify(s.m_clauses);
+        s.propagate(false);
+        sw.stop();
+        IF_VERBOSE(2, verbose_stream() << " (sat-vivify :clauses " << (m_vivified - vivified0)
+                   << " :elim-literals " << (m_elim_literals - elim0)
+                   << " :cost " << (m_vivify_limit - m_vivify_counter) << sw << ")\n";);
+    }
+
+    void asymm_branch::vivify(clause_vector& clauses) {
+        clause_vector::iterator it  = clauses.begin();
+        clause_vector::iterator it2 = it;
+        clause_vector::iterator end = clauses.end();
+        try {
+            for (; it != end; ++it) {
+                clause & c = *(*it);
+                if (m_vivify_counter < 0 || s.inconsistent() || c.was_removed() || c.frozen()) {
+                    *it2 = *it;
+                    ++it2;
+                    continue;
+                }
+                s.checkpoint();
+                if (!vivify(c)) {
+                    continue; // clause was removed
+                }
+                *it2 = *it;
+                ++it2;
+            }
+            clauses.set_end(it2);
+        }
+        catch (solver_exception & ex) {
+            for (; it != end; ++it, ++it2) {
+                *it2 = *it;
+            }
+            clauses.set_end(it2);
+            throw ex;
+        }
+    }
+
+    /**
+       \brief Assign the negations of the literals of c in turn and propagate, 
+       using the other clauses. The clause can be shortened to the literals
+       assigned so far when propagation produces a conflict or makes the next
+       literal true. Literals that propagation makes false are removed.
+    */
+    bool asymm_branch::vivify(clause & c) {
+        SASSERT(s.scope_lvl() == 0);
+        SASSERT(!s.inconsistent());
+        for (literal l : c) {
+            if (s.value(l) == l_true) {
+                s.detach_clause(c);
+                s.del_clause(c);
+                return false;
+            }
+        }
+        unsigned sz = c.size();
+        m_vivify_counter -= sz;
+        scoped_detach scoped_d(s, c);
+        unsigned new_sz = 0;
+        unsigned trail_sz = s.m_trail.size();
+        s.push();
+        for (unsigned i = 0; i < sz; ++i) {
+            literal l = c[i];
+            lbool val = s.value(l);
+            if (val == l_false) 
+                continue;
+            std::swap(c[new_sz++], c[i]);
+            if (val == l_true) 
+                break;
+            s.assign_scoped(~l);
+            s.propagate_core(false); // must not use propagate(), since check_missed_propagation may fail for c
+            if (s.inconsistent())
+                break;
+        }
+        m_vivify_counter -= s.m_trail.size() - trail_sz;
+        s.pop(1);
+        if (new_sz == sz) 
+            return true;
+        ++m_vivified;
+        return re_attach(scoped_d, c, new_sz);
+    }
+
     bool asymm_branch::process_sampled(big& big, clause & c) {
         scoped_detach scoped_d(s, c);
         sort(big, c);
@@ -480,6 +578,8 @@ namespace sat {
         m_asymm_branch_all     = p.asymm_branch_all();
         if (m_asymm_branch_limit > UINT_MAX)
             m_asymm_branch_limit = UINT_MAX;
+        m_vivify               = p.vivify();
+        m_vivify_limit         = p.vivify_limit();
     }
 
     void asymm_branch::collect_param_descrs(param_descrs & d) {
@@ -489,12 +589,14 @@ namespace sat {
     void asymm_branch::collect_statistics(statistics & st) const {
         st.update("sat elim literals", m_elim_literals);
         st.update("sat tr", m_tr);
+        st.update("sat vivified clauses", m_vivified);
     }
 
     void asymm_branch::reset_statistics() {
         m_elim_literals = 0;
         m_elim_learned_literals = 0;
         m_tr = 0;
+        m_vivified = 0;
     }
 
 };
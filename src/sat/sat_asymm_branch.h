@@ -44,11 +44,15 @@ namespace sat {
         bool       m_asymm_branch_sampled;
         bool       m_asymm_branch_all;
         int64_t    m_asymm_branch_limit;
+        bool       m_vivify;
+        int64_t    m_vivify_limit;
 
         // stats
         unsigned   m_elim_literals;
         unsigned   m_elim_learned_literals;
         unsigned   m_tr;
+        unsigned   m_vivified;
+        int64_t    m_vivify_counter;
 
         literal_vector m_pos, m_neg; // literals (complements of literals) in clauses sorted by discovery time (m_left in BIG).
         svector<std::pair<literal, unsigned>> m_pos1, m_neg1;
@@ -90,6 +94,12 @@ namespace sat {
 
         bool propagate_literal(clause const& c, literal l);
 
+        void vivify();
+
+        void vivify(clause_vector& clauses);
+
+        bool vivify(clause& c);
+
     public:
         asymm_branch(solver & s, params_ref const & p);
 
@@ -37,6 +37,14 @@ namespace sat {
 
     std::ostream & operator<<(std::ostream & out, clause const & c);
 
+    /**
+       \brief Tiers of learned clauses used by the tiered garbage collection.
+       Core clauses are kept until they stay unused for several collections,
+       tier-2 clauses are kept while they are used, and local clauses are
+       candidates for deletion.
+    */
+    enum clause_tier { TIER_CORE = 0, TIER_2 = 1, TIER_LOCAL = 2 };
+
     class clause {
         friend class clause_allocator;
         friend class tmp_clause;
@@ -53,6 +61,7 @@ namespace sat {
         unsigned           m_inact_rounds:8;
         unsigned           m_glue:8;
         unsigned           m_psm:8;  // transient field used during gc
+        unsigned           m_tier:2; // tier of learned clause used by tiered gc
         literal            m_lits[0];
 
         static size_t get_obj_size(unsigned num_lits) { return sizeof(clause) + num_lits * sizeof(literal); }
@@ -98,6 +107,8 @@ namespace sat {
         unsigned glue() const { return m_glue; }
         void set_psm(unsigned psm) { m_psm = psm > 255 ? 255 : psm; }
         unsigned psm() const { return m_psm; }
+        unsigned tier() const { return m_tier; }
+        void set_tier(unsigned t) { m_tier = t; }
         clause_offset get_new_offset() const;
         void set_new_offset(clause_offset off); 
 
@@ -91,6 +91,9 @@ namespace sat {
         
         m_max_conflicts   = p.max_conflicts();
         m_num_threads     = p.threads();
+        m_par_export_max_size = p.threads_export_max_size();
+        m_par_export_max_glue = p.threads_export_max_glue();
+        m_par_buffer_size = p.threads_buffer_size();
         m_ddfw_search     = p.ddfw_search();
         m_ddfw_threads    = p.ddfw_threads();
         m_prob_search     = p.prob_search();
@@ -174,16 +177,22 @@ namespace sat {
             m_gc_strategy = GC_PSM;
         else if (s == symbol("psm_glue"))
             m_gc_strategy = GC_PSM_GLUE;
+        else if (s == symbol("tiered"))
+            m_gc_strategy = GC_TIERED;
         else 
             throw sat_param_exception("invalid gc strategy");
         m_gc_initial      = p.gc_initial();
         m_gc_increment    = p.gc_increment();
         m_gc_small_lbd    = p.gc_small_lbd();
         m_gc_k            = std::min(255u, p.gc_k());
+        m_gc_tier1_glue   = p.gc_tier1_glue();
+        m_gc_tier2_glue   = p.gc_tier2_glue();
+        m_gc_tier1_rounds = std::min(255u, p.gc_tier1_rounds());
         m_gc_burst        = p.gc_burst();
         m_gc_defrag       = p.gc_defrag();
 
         m_force_cleanup   = p.force_cleanup();
+        m_reuse_trail     = p.reuse_trail();
 
         m_backtrack_scopes = p.backtrack_scopes();
         m_backtrack_init_conflicts = p.backtrack_conflicts();
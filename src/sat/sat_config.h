@@ -44,7 +44,8 @@ namespace sat {
         GC_PSM,
         GC_GLUE,
         GC_GLUE_PSM,
-        GC_PSM_GLUE
+        GC_PSM_GLUE,
+        GC_TIERED
     };
 
     enum branching_heuristic {
@@ -111,6 +112,9 @@ namespace sat {
         bool               m_enable_pre_simplify;
         unsigned           m_max_conflicts;
         unsigned           m_num_threads;
+        unsigned           m_par_export_max_size;
+        unsigned           m_par_export_max_glue;
+        unsigned           m_par_buffer_size;
         bool               m_ddfw_search;
         unsigned           m_ddfw_threads;
         bool               m_prob_search;
@@ -159,10 +163,14 @@ namespace sat {
         unsigned           m_gc_increment;
         unsigned           m_gc_small_lbd;
         unsigned           m_gc_k;
+        unsigned           m_gc_tier1_glue;
+        unsigned           m_gc_tier2_glue;
+        unsigned           m_gc_tier1_rounds;
         bool               m_gc_burst;
         bool               m_gc_defrag;
 
         bool               m_force_cleanup;
+        bool               m_reuse_trail;
 
         // backtracking
         unsigned           m_backtrack_scopes;
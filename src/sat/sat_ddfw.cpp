@@ -32,15 +32,11 @@
 
 namespace sat {
 
-    ddfw::~ddfw() {
-        for (auto& ci : m_clauses) {
-            m_alloc.del_clause(ci.m_clause);
-        }
-    }
-
 
     lbool ddfw::check(unsigned sz, literal const* assumptions, parallel* p) {
         init(sz, assumptions);
+        if (m_unsat.empty())
+            save_best_values();
         flet<parallel*> _p(m_par, p);
         while (m_limit.inc() && m_min_sz > 0) {
             if (should_reinit_weights()) do_reinit_weights();
@@ -127,21 +123,25 @@ namespace sat {
 
 
     void ddfw::add(unsigned n, literal const* c) {        
-        clause* cls = m_alloc.mk_clause(n, c, false);
         unsigned idx = m_clauses.size();
-        m_clauses.push_back(clause_info(cls, m_config.m_init_clause_weight));
-        for (literal lit : *cls) {
+        m_clauses.push_back(clause_info(m_config.m_init_clause_weight));
+        if (m_clause_index.empty())
+            m_clause_index.push_back(0);
+        m_clause_lits.append(n, c);
+        m_clause_index.push_back(m_clause_lits.size());
+        for (unsigned i = 0; i < n; ++i) {
+            literal lit = c[i];
             m_use_list.reserve(2*(lit.var()+1));
             m_vars.reserve(lit.var()+1);
+            m_reward_avg.reserve(lit.var()+1, ema(1e-5));
             m_use_list[lit.index()].push_back(idx);
         }
     }
 
     void ddfw::add(solver const& s) {
-        for (auto& ci : m_clauses) {
-            m_alloc.del_clause(ci.m_clause);
-        }
         m_clauses.reset(); 
+        m_clause_lits.reset();
+        m_clause_index.reset();
         m_use_list.reset();
         m_num_non_binary_clauses = 0;
 
@@ -240,7 +240,7 @@ namespace sat {
             switch (ci.m_num_trues) {
             case 0: {
                 m_unsat.insert(cls_idx);
-                clause const& c = get_clause(cls_idx);
+                auto c = get_clause(cls_idx);
                 for (literal l : c) {
                     inc_reward(l, w);
                     inc_make(l);
@@ -263,7 +263,7 @@ namespace sat {
             switch (ci.m_num_trues) {
             case 0: {
                 m_unsat.remove(cls_idx);   
-                clause const& c = get_clause(cls_idx);
+                auto c = get_clause(cls_idx);
                 for (literal l : c) {
                     dec_reward(l, w);
                     dec_make(l);
@@ -319,7 +319,7 @@ namespace sat {
         unsigned sz = m_clauses.size();
         for (unsigned i = 0; i < sz; ++i) {
             auto& ci = m_clauses[i];
-            clause const& c = get_clause(i);
+            auto c = get_clause(i);
             ci.m_trues = 0;
             ci.m_num_trues = 0;
             for (literal lit : c) {
@@ -383,18 +383,18 @@ namespace sat {
             // Sum exp(xi) / exp(a) = Sum exp(xi - a)
             double max_avg = 0;
             for (unsigned v = 0; v < num_vars(); ++v) {
-                max_avg = std::max(max_avg, (double)m_vars[v].m_reward_avg);
+                max_avg = std::max(max_avg, (double)m_reward_avg[v]);
             }
             double sum = 0;
             for (unsigned v = 0; v < num_vars(); ++v) {
-                sum += exp(m_config.m_itau * (m_vars[v].m_reward_avg - max_avg));
+                sum += exp(m_config.m_itau * (m_reward_avg[v] - max_avg));
             }
             if (sum == 0) {
                 sum = 0.01;
             }
             m_probs.reset();
             for (unsigned v = 0; v < num_vars(); ++v) {
-                m_probs.push_back(exp(m_config.m_itau * (m_vars[v].m_reward_avg - max_avg)) / sum);
+                m_probs.push_back(exp(m_config.m_itau * (m_reward_avg[v] - max_avg)) / sum);
             }
             m_par->to_solver(*this);
         }
@@ -462,7 +462,7 @@ namespace sat {
     }
 
     unsigned ddfw::select_max_same_sign(unsigned cf_idx) {
-        clause const& c = get_clause(cf_idx);
+        auto c = get_clause(cf_idx);
         unsigned max_weight = 2;
         unsigned max_trues = 0;
         unsigned cl = UINT_MAX; // clause pointer to same sign, max weight satisfied clause.
@@ -514,7 +514,8 @@ namespace sat {
     std::ostream& ddfw::display(std::ostream& out) const {
         unsigned num_cls = m_clauses.size();
         for (unsigned i = 0; i < num_cls; ++i) {
-            out << get_clause(i) << " ";
+            for (literal lit : get_clause(i))
+                out << lit << " ";
             auto const& ci = m_clauses[i];
             out << ci.m_num_trues << " " << ci.m_weight << "\n";
         }
@@ -580,6 +581,13 @@ namespace sat {
             });
     }
 
+    void ddfw::collect_statistics(statistics& st) const {
+        st.update("sat ddfw flips", static_cast<double>(m_flips));
+        st.update("sat ddfw shifts", static_cast<double>(m_shifts));
+        st.update("sat ddfw restarts", m_restart_count);
+        st.update("sat ddfw reinits", m_reinit_count);
+    }
+
     void ddfw::updt_params(params_ref const& _p) {
         sat_params p(_p);
         m_config.m_init_clause_weight = p.ddfw_init_clause_weight();
@@ -33,12 +33,14 @@ namespace sat {
 
     class ddfw : public i_local_search {
 
+        // the state of clauses and variables that is updated on flips is kept 
+        // in small records, separate from the clause literals and the 
+        // variable statistics used for parallel integration.
         struct clause_info {
-            clause_info(clause* cl, unsigned init_weight): m_weight(init_weight), m_trues(0), m_num_trues(0), m_clause(cl) {}
+            clause_info(unsigned init_weight): m_weight(init_weight), m_trues(0), m_num_trues(0) {}
             unsigned m_weight;       // weight of clause
             unsigned m_trues;        // set of literals that are true
             unsigned m_num_trues;    // size of true set
-            clause*  m_clause;
             bool is_true() const { return m_num_trues > 0; }
             void add(literal lit) { ++m_num_trues; m_trues += lit.index(); }
             void del(literal lit) { SASSERT(m_num_trues > 0); --m_num_trues; m_trues -= lit.index(); }
@@ -65,20 +67,30 @@ namespace sat {
         };
 
         struct var_info {
-            var_info(): m_value(false), m_reward(0), m_make_count(0), m_bias(0), m_reward_avg(1e-5) {}
+            var_info(): m_value(false), m_reward(0), m_make_count(0), m_bias(0) {}
             bool     m_value;
             int      m_reward;
             unsigned m_make_count;
             int      m_bias;
-            ema      m_reward_avg;
+        };
+
+        class clause_lits {
+            literal const* m_begin;
+            literal const* m_end;
+        public:
+            clause_lits(literal const* b, literal const* e): m_begin(b), m_end(e) {}
+            literal const* begin() const { return m_begin; }
+            literal const* end() const { return m_end; }
         };
         
         config           m_config;
         reslimit         m_limit;
-        clause_allocator m_alloc;
         svector<clause_info> m_clauses;
+        literal_vector       m_clause_lits;   // literals of clause i are at [m_clause_index[i], m_clause_index[i + 1])
+        unsigned_vector      m_clause_index;
         literal_vector       m_assumptions;        
         svector<var_info>    m_vars;        // var -> info
+        svector<ema>         m_reward_avg;  // var -> average reward
         svector<double>      m_probs;       // var -> probability of flipping
         svector<double>      m_scores;      // reward -> score
         model                m_model;       // var -> best assignment
@@ -134,13 +146,16 @@ namespace sat {
 
         inline bool is_true(literal lit) const { return value(lit.var()) != lit.sign(); }
 
-        inline clause const& get_clause(unsigned idx) const { return *m_clauses[idx].m_clause; }
+        inline clause_lits get_clause(unsigned idx) const { 
+            literal const* lits = m_clause_lits.data();
+            return clause_lits(lits + m_clause_index[idx], lits + m_clause_index[idx + 1]);
+        }
 
         inline unsigned get_weight(unsigned idx) const { return m_clauses[idx].m_weight; }
 
         inline bool is_true(unsigned idx) const { return m_clauses[idx].is_true(); }
 
-        void update_reward_avg(bool_var v) { m_vars[v].m_reward_avg.update(reward(v)); }
+        void update_reward_avg(bool_var v) { m_reward_avg[v].update(reward(v)); }
 
         unsigned select_max_same_sign(unsigned cf_idx);
 
@@ -197,7 +212,6 @@ namespace sat {
 
         ddfw(): m_par(nullptr) {}
 
-        ~ddfw() override;
 
         lbool check(unsigned sz, literal const* assumptions, parallel* p) override;
 
@@ -217,7 +231,7 @@ namespace sat {
         unsigned num_non_binary_clauses() const override { return m_num_non_binary_clauses; }
         void reinit(solver& s) override;
 
-        void collect_statistics(statistics& st) const override {} 
+        void collect_statistics(statistics& st) const override;
 
         double get_priority(bool_var v) const override { return m_probs[v]; }
     };
@@ -19,6 +19,8 @@ Author:
 Notes:
 
 --*/
+#include "util/warning.h"
+#include "util/async_ofstream.h"
 #include "sat_solver.h"
 #include "sat_drat.h"
 
@@ -36,7 +38,7 @@ namespace sat {
     {
         if (s.get_config().m_drat && s.get_config().m_drat_file.is_non_empty_string()) {
             auto mode = s.get_config().m_drat_binary ? (std::ios_base::binary | std::ios_base::out | std::ios_base::trunc) : std::ios_base::out;
-            m_out = alloc(std::ofstream, s.get_config().m_drat_file.str(), mode);
+            m_out = alloc(async_ofstream, s.get_config().m_drat_file.str().c_str(), mode);
             if (s.get_config().m_drat_binary) {
                 std::swap(m_out, m_bout);
             }
@@ -44,8 +46,10 @@ namespace sat {
     }
 
     drat::~drat() {
-        if (m_out) m_out->flush();
-        if (m_bout) m_bout->flush();
+        if (m_out) m_out->close();
+        if (m_bout) m_bout->close();
+        if ((m_out && m_out->fail()) || (m_bout && m_bout->fail()))
+            warning_msg("could not write DRAT proof to '%s'", s.get_config().m_drat_file.str().c_str());
         dealloc(m_out);
         dealloc(m_bout);
         for (unsigned i = 0; i < m_proof.size(); ++i) {
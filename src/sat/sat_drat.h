@@ -17,6 +17,10 @@ Notes:
 
     For DIMACS input it produces DRAT proofs.
 
+    Proofs are written to the file by a background thread in large
+    blocks, so that logging does not wait for the file system.
+    A warning is issued if the proof file could not be written.
+
     For SMT extensions are as follows:
 
     Input assertion:
@@ -56,6 +60,8 @@ Notes:
 
 #include "sat_types.h"
 
+class async_ofstream;
+
 namespace sat {
     class justification;
     class clause;
@@ -77,8 +83,8 @@ namespace sat {
         typedef svector<unsigned> watch;
         solver& s;
         clause_allocator        m_alloc;
-        std::ostream*           m_out;
-        std::ostream*           m_bout;
+        async_ofstream*         m_out;
+        async_ofstream*         m_bout;
         ptr_vector<clause>      m_proof;
         svector<status>         m_status;        
         literal_vector          m_units;
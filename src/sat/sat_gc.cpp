@@ -57,6 +57,9 @@ namespace sat {
         case GC_PSM_GLUE:
             gc_psm_glue();
             break;
+        case GC_TIERED:
+            gc_tiered();
+            break;
         case GC_DYN_PSM:
             if (!m_assumptions.empty()) {
                 gc_glue_psm();
@@ -304,6 +307,90 @@ namespace sat {
                    " :frozen " << frozen << " :activated " << activated << " :deleted " << deleted << ")\n";);
     }
 
+    /**
+       \brief Tiered gc. Learned clauses with glue at most gc.tier1_glue are kept (core)
+       as long as they are used within gc.tier1_rounds collections. Core clauses that
+       stay unused for longer are deleted, so the core only grows with clauses that
+       are still in use.
+       Clauses with glue at most gc.tier2_glue that were used since the last gc
+       are promoted to tier 2, and tier 2 clauses that were not used are demoted
+       to the local tier. Local clauses that were not used since the last gc are
+       candidates for deletion, and the worse half of them (by glue, then size) is
+       deleted. Only the candidates are ranked, the learned clauses are not sorted.
+       Tiers are assigned from the glue at the time of the collection, so a clause
+       whose glue was lowered when it propagated (see propagate_literal) moves to
+       the tier of its new glue.
+    */
+    void solver::gc_tiered() {
+        unsigned tier1 = m_config.m_gc_tier1_glue;
+        unsigned tier2 = m_config.m_gc_tier2_glue;
+        unsigned tier1_rounds = m_config.m_gc_tier1_rounds;
+        auto is_candidate = [&](clause const& c) {
+            return !c.was_used() && c.tier() == TIER_LOCAL && c.glue() > tier1 && !c.frozen() && can_delete(c);
+        };
+        auto key = [&](clause const& c) {
+            return (static_cast<uint64_t>(c.glue()) << 32) + c.size();
+        };
+        svector<uint64_t> keys;
+        for (clause* c : m_learned) 
+            if (is_candidate(*c))
+                keys.push_back(key(*c));
+        unsigned num_del = keys.size() / 2;
+        uint64_t threshold = 0;
+        unsigned num_ties = 0;
+        if (num_del > 0) {
+            // delete the num_del candidates with largest keys
+            auto nth = keys.begin() + (keys.size() - num_del);
+            std::nth_element(keys.begin(), nth, keys.end());
+            threshold = *nth;
+            for (auto it = nth; it != keys.end(); ++it) 
+                if (*it == threshold)
+                    ++num_ties;
+        }
+        unsigned num_core = 0, num_tier2 = 0, deleted = 0, aged = 0;
+        unsigned j = 0;
+        for (clause* cp : m_learned) {
+            clause& c = *cp;
+            if (num_del > 0 && is_candidate(c)) {
+                uint64_t k = key(c);
+                if (k > threshold || (k == threshold && num_ties > 0)) {
+                    if (k == threshold)
+                        --num_ties;
+                    detach_clause(c);
+                    del_clause(c);
+                    ++deleted;
+                    continue;
+                }
+            }
+            bool used = c.was_used();
+            c.unmark_used();
+            if (used)
+                c.reset_inact_rounds();
+            else if (c.inact_rounds() < 255)
+                c.inc_inact_rounds();
+            if (c.glue() <= tier1) {
+                if (c.inact_rounds() >= tier1_rounds && !c.frozen() && can_delete(c)) {
+                    detach_clause(c);
+                    del_clause(c);
+                    ++aged;
+                    continue;
+                }
+                c.set_tier(TIER_CORE);
+            }
+            else if (used && c.glue() <= tier2 && c.tier() == TIER_LOCAL)
+                c.set_tier(TIER_2);
+            else if (!used && c.tier() == TIER_2)
+                c.set_tier(TIER_LOCAL);
+            num_core += c.tier() == TIER_CORE;
+            num_tier2 += c.tier() == TIER_2;
+            m_learned[j++] = &c;
+        }
+        m_learned.shrink(j);
+        m_stats.m_gc_clause += deleted + aged;
+        IF_VERBOSE(SAT_VB_LVL, verbose_stream() << "(sat-gc :strategy tiered :core " << num_core << " :tier2 " << num_tier2 
+                   << " :local " << (j - num_core - num_tier2) << " :aged " << aged << " :deleted " << deleted << ")\n";);
+    }
+
     // return true if should keep the clause, and false if we should delete it.
     bool solver::activate_frozen_clause(clause & c) {
         TRACE("sat_gc", tout << "reactivating:\n" << c << "\n";);
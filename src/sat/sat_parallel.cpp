@@ -22,75 +22,71 @@ Revision History:
 
 namespace sat {
 
-    void parallel::vector_pool::next(unsigned& index) {
-        SASSERT(index < m_size);
-        unsigned n = index + 2 + get_length(index);
-        if (n >= m_size) {
-            index = 0;
-        }
-        else {
-            index = n;
-        }
-    }
-
-    void parallel::vector_pool::reserve(unsigned num_threads, unsigned sz) {
-        m_vectors.reset();
-        m_vectors.resize(sz, 0);
-        m_heads.reset();
-        m_heads.resize(num_threads, 0);
-        m_at_end.reset();
-        m_at_end.resize(num_threads, true);
-        m_tail = 0;
-        m_size = sz;
-    }
-    
-    void parallel::vector_pool::begin_add_vector(unsigned owner, unsigned n) {
-        SASSERT(m_tail < m_size);
-        unsigned capacity = n + 2;
-        m_vectors.reserve(m_size + capacity, 0);
-        IF_VERBOSE(3, verbose_stream() << owner << ": begin-add " << n << " tail: " << m_tail << " size: " << m_size << "\n";);
-        for (unsigned i = 0; i < m_heads.size(); ++i) {
-            while (m_tail < m_heads[i] && m_heads[i] < m_tail + capacity) {
-                next(m_heads[i]);
-            }
-            m_at_end[i] = false;
-        }
-        m_vectors[m_tail++] = owner;
-        m_vectors[m_tail++] = n;    
+    parallel::clause_ring::~clause_ring() {
+        dealloc_svect(m_data);
     }
 
-    void parallel::vector_pool::add_vector_elem(unsigned e) {
-        m_vectors[m_tail++] = e;
+    void parallel::clause_ring::reserve(unsigned sz) {
+        unsigned cap = 16;
+        while (cap < sz) 
+            cap *= 2;
+        dealloc_svect(m_data);
+        m_data = alloc_svect(std::atomic<unsigned>, cap);
+        for (unsigned i = 0; i < cap; ++i) 
+            m_data[i].store(0, std::memory_order_relaxed);
+        m_mask = cap - 1;
+        m_reserved.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_relaxed);
     }
 
-    void parallel::vector_pool::end_add_vector() {
-        if (m_tail >= m_size) {
-            m_tail = 0;
-        }
+    /**
+       \brief append a clause to the ring. Only the owner of the ring may call this method.
+       The reservation counter is published before the slots are overwritten so that 
+       readers can detect that a clause they copied was clobbered concurrently.
+     */
+    bool parallel::clause_ring::push(unsigned n, literal const* lits) {
+        if (4 * (n + 1) > capacity()) 
+            return false;
+        uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        uint64_t end = tail + n + 1;
+        m_reserved.store(end, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_data[tail & m_mask].store(n, std::memory_order_relaxed);
+        for (unsigned i = 0; i < n; ++i) 
+            m_data[(tail + i + 1) & m_mask].store(lits[i].index(), std::memory_order_relaxed);
+        m_tail.store(end, std::memory_order_release);
+        return true;
     }
 
-
-    bool parallel::vector_pool::get_vector(unsigned owner, unsigned& n, unsigned const*& ptr) {
-        unsigned head = m_heads[owner];      
-        unsigned iterations = 0;
-        while (head != m_tail || !m_at_end[owner]) {
-            ++iterations;
-            SASSERT(head < m_size && m_tail < m_size);            
-            bool is_self = owner == get_owner(head);
-            next(m_heads[owner]);
-            IF_VERBOSE(static_cast<unsigned>(iterations > m_size ? 0 : 3), verbose_stream() << owner << ": [" << head << ":" << m_heads[owner] << "] tail: " << m_tail << "\n";);
-            m_at_end[owner] = (m_heads[owner] == m_tail);
-            if (!is_self) {
-                n = get_length(head);
-                ptr = get_ptr(head);
-                return true;
+    /**
+       \brief retrieve the next clause after head. 
+       Clauses that were overwritten before the reader got to them are skipped and counted in num_dropped.
+     */
+    bool parallel::clause_ring::get_clause(uint64_t& head, literal_vector& lits, unsigned& num_dropped) const {
+        while (true) {
+            uint64_t tail = m_tail.load(std::memory_order_acquire);
+            if (head == tail) 
+                return false;
+            if (tail - head <= capacity()) {
+                unsigned n = m_data[head & m_mask].load(std::memory_order_relaxed);
+                lits.reset();
+                if (0 < n && 4 * (n + 1) <= capacity()) {
+                    for (unsigned i = 0; i < n; ++i) 
+                        lits.push_back(to_literal(m_data[(head + i + 1) & m_mask].load(std::memory_order_relaxed)));
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (m_reserved.load(std::memory_order_relaxed) - head <= capacity()) {
+                        head += n + 1;
+                        return true;
+                    }
+                }
             }
-            head = m_heads[owner];
+            // the producer overtook this reader.
+            ++num_dropped;
+            head = tail;
         }
-        return false;
     }
 
-    parallel::parallel(solver& s): m_num_clauses(0), m_consumer_ready(false), m_scoped_rlimit(s.rlimit()) {}
+    parallel::parallel(solver& s): m_cursor_stride(0), m_num_clauses(0), m_consumer_ready(false), m_scoped_rlimit(s.rlimit()) {}
 
     parallel::~parallel() {
         for (unsigned i = 0; i < m_solvers.size(); ++i) {            
@@ -98,6 +94,18 @@ namespace sat {
         }
     }
 
+    void parallel::reserve(unsigned num_owners, unsigned sz) {
+        m_rings.reset();
+        for (unsigned i = 0; i < num_owners; ++i) {
+            m_rings.push_back(alloc(clause_ring));
+            m_rings.back()->reserve(sz);
+        }
+        // pad rows of cursors to separate cache lines; each row is updated by a different thread.
+        m_cursor_stride = (num_owners + 7) & ~7u;
+        m_cursors.reset();
+        m_cursors.resize(num_owners * m_cursor_stride, 0);
+    }
+
     void parallel::init_solvers(solver& s, unsigned num_extra_solvers) {
         unsigned num_threads = num_extra_solvers + 1;
         m_solvers.init(num_extra_solvers);
@@ -145,61 +153,55 @@ namespace sat {
 
     void parallel::share_clause(solver& s, literal l1, literal l2) {        
         if (s.get_config().m_num_threads == 1 || s.m_par_syncing_clauses) return;
-        flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
         IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": share " <<  l1 << " " << l2 << "\n";);
-        {
-            lock_guard lock(m_mux);
-            m_pool.begin_add_vector(s.m_par_id, 2);
-            m_pool.add_vector_elem(l1.index());
-            m_pool.add_vector_elem(l2.index());            
-            m_pool.end_add_vector();
-        }        
+        literal lits[2] = { l1, l2 };
+        if (m_rings[s.m_par_id]->push(2, lits))
+            s.m_stats.m_par_exported++;
     }
 
     void parallel::share_clause(solver& s, clause const& c) {        
-        if (s.get_config().m_num_threads == 1 || !enable_add(c) || s.m_par_syncing_clauses) return;
-        flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        unsigned n = c.size();
-        unsigned owner = s.m_par_id;
-        IF_VERBOSE(3, verbose_stream() << owner << ": share " <<  c << "\n";);
-        lock_guard lock(m_mux);
-        m_pool.begin_add_vector(owner, n);                
-        for (unsigned i = 0; i < n; ++i) {
-            m_pool.add_vector_elem(c[i].index());
+        if (s.get_config().m_num_threads == 1 || s.m_par_syncing_clauses) return;
+        if (!enable_add(s, c)) {
+            s.m_stats.m_par_filtered++;
+            return;
         }
-        m_pool.end_add_vector();        
+        IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": share " <<  c << "\n";);
+        if (m_rings[s.m_par_id]->push(c.size(), c.begin()))
+            s.m_stats.m_par_exported++;
+        else
+            s.m_stats.m_par_filtered++;
     }
 
     void parallel::get_clauses(solver& s) {
         if (s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        lock_guard lock(m_mux);
-        _get_clauses(s);        
-    }
-
-    void parallel::_get_clauses(solver& s) {
-        unsigned n;
-        unsigned const* ptr;
         unsigned owner = s.m_par_id;
-        while (m_pool.get_vector(owner, n, ptr)) {
-            m_lits.reset();
-            bool usable_clause = true;
-            for (unsigned i = 0; usable_clause && i < n; ++i) {
-                literal lit(to_literal(ptr[i]));                
-                m_lits.push_back(lit);
-                usable_clause = lit.var() <= s.m_par_num_vars && !s.was_eliminated(lit.var());
-            }
-            IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": retrieve " << m_lits << "\n";);
-            SASSERT(n >= 2);
-            if (usable_clause) {
-                s.mk_clause_core(m_lits.size(), m_lits.data(), sat::status::redundant());
+        uint64_t* cursors = m_cursors.data() + owner * m_cursor_stride;
+        literal_vector lits;
+        for (unsigned p = 0; p < m_rings.size() && !s.inconsistent(); ++p) {
+            if (p == owner)
+                continue;
+            clause_ring const& ring = *m_rings[p];
+            if (cursors[p] == ring.tail())
+                continue;
+            while (!s.inconsistent() && ring.get_clause(cursors[p], lits, s.m_stats.m_par_dropped)) {
+                bool usable_clause = true;
+                for (literal lit : lits) 
+                    usable_clause &= lit.var() <= s.m_par_num_vars && !s.was_eliminated(lit.var());
+                IF_VERBOSE(3, verbose_stream() << owner << ": retrieve " << lits << "\n";);
+                SASSERT(lits.size() >= 2);
+                if (usable_clause) {
+                    s.mk_clause_core(lits.size(), lits.data(), sat::status::redundant());
+                    s.m_stats.m_par_imported++;
+                }
             }
-        }        
+        }
     }
 
-    bool parallel::enable_add(clause const& c) const {
+    bool parallel::enable_add(solver& s, clause const& c) const {
         // plingeling, glucose heuristic:
-        return (c.size() <= 40 && c.glue() <= 8) || c.glue() <= 2;
+        config const& cfg = s.get_config();
+        return (c.size() <= cfg.m_par_export_max_size && c.glue() <= cfg.m_par_export_max_glue) || c.glue() <= 2;
     }
 
     void parallel::_from_solver(solver& s) {
@@ -24,33 +24,33 @@ Revision History:
 #include "util/rlimit.h"
 #include "util/scoped_ptr_vector.h"
 #include "util/mutex.h"
+#include <atomic>
 
 namespace sat {
 
     class parallel {
 
-        // shared pool of learned clauses.
-        class vector_pool {
-            unsigned_vector m_vectors;
-            unsigned        m_size{ 0 };
-            unsigned        m_tail{ 0 };
-            unsigned_vector m_heads;
-            bool_vector   m_at_end;
-            void next(unsigned& index);
-            unsigned get_owner(unsigned index) const { return m_vectors[index]; }
-            unsigned get_length(unsigned index) const { return m_vectors[index+1]; }
-            unsigned const* get_ptr(unsigned index) const { return m_vectors.data() + index + 2; }
+        // Single-producer ring of learned clauses.
+        // Only the owning solver appends to the ring; other solvers read it
+        // through private cursors without taking a lock. A clause is stored
+        // as its size followed by the literal indices. The producer never waits
+        // for readers: a reader that is overtaken by more than the capacity
+        // of the ring drops the overwritten clauses and resumes at the tail.
+        class clause_ring {
+            unsigned                m_mask { 0 };
+            std::atomic<unsigned>*  m_data { nullptr };
+            std::atomic<uint64_t>   m_reserved { 0 };  // end of the region that may be under construction
+            std::atomic<uint64_t>   m_tail { 0 };      // end of the region that is fully written
         public:
-            vector_pool() {}
-            void reserve(unsigned num_owners, unsigned sz);
-            void begin_add_vector(unsigned owner, unsigned n);
-            void end_add_vector();
-            void add_vector_elem(unsigned e);
-            bool get_vector(unsigned owner, unsigned& n, unsigned const*& ptr);
+            ~clause_ring();
+            void reserve(unsigned sz);
+            unsigned capacity() const { return m_mask + 1; }
+            uint64_t tail() const { return m_tail.load(std::memory_order_acquire); }
+            bool push(unsigned n, literal const* lits);
+            bool get_clause(uint64_t& head, literal_vector& lits, unsigned& num_dropped) const;
         };
 
-        bool enable_add(clause const& c) const;
-        void _get_clauses(solver& s);
+        bool enable_add(solver& s, clause const& c) const;
         void _from_solver(solver& s);
         bool _to_solver(solver& s);
         bool _from_solver(i_local_search& s);
@@ -59,9 +59,10 @@ namespace sat {
         typedef hashtable<unsigned, u_hash, u_eq> index_set;
         literal_vector m_units;
         index_set      m_unit_set;
-        literal_vector m_lits;
-        vector_pool    m_pool;
-        mutex          m_mux;
+        scoped_ptr_vector<clause_ring> m_rings;
+        svector<uint64_t>              m_cursors;  // m_cursors[reader*m_cursor_stride + producer]
+        unsigned                       m_cursor_stride;
+        mutex                          m_mux;      // protects units and exchange with local search
 
         // for exchange with local search:
         unsigned           m_num_clauses;
@@ -83,8 +84,8 @@ namespace sat {
 
         void push_child(reslimit& rl);
 
-        // reserve space
-        void reserve(unsigned num_owners, unsigned sz) { m_pool.reserve(num_owners, sz); }
+        // reserve one exchange ring of sz literal slots per owner
+        void reserve(unsigned num_owners, unsigned sz);
 
         solver& get_solver(unsigned i) { return *m_solvers[i]; }
 
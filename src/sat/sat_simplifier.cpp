@@ -25,6 +25,7 @@ Revision History:
 #include "sat/sat_integrity_checker.h"
 #include "util/stopwatch.h"
 #include "util/trace.h"
+#include "util/worker_pool.h"
 
 namespace sat {
 
@@ -1804,17 +1805,21 @@ namespace sat {
        Return false if the result is a tautology
     */
     bool simplifier::resolve(clause_wrapper const & c1, clause_wrapper const & c2, literal l, literal_vector & r) {
+        m_elim_counter -= c1.size() + c2.size();
+        return resolve(c1, c2, l, r, m_visited);
+    }
+
+    bool simplifier::resolve(clause_wrapper const & c1, clause_wrapper const & c2, literal l, literal_vector & r, svector<char> & visited) {
         CTRACE("resolve_bug", !c1.contains(l), tout << c1 << "\n" << c2 << "\nl: " << l << "\n";);
         SASSERT(c1.contains(l));
         SASSERT(c2.contains(~l));
         bool res = true;
-        m_elim_counter -= c1.size() + c2.size();
         unsigned sz1 = c1.size();
         for (unsigned i = 0; i < sz1; ++i) {
             literal l1 = c1[i];
             if (l == l1)
                 continue;
-            m_visited[l1.index()] = true;
+            visited[l1.index()] = true;
             r.push_back(l1);
         }
 
@@ -1824,17 +1829,17 @@ namespace sat {
             literal l2 = c2[i];
             if (not_l == l2)
                 continue;
-            if (m_visited[(~l2).index()]) {
+            if (visited[(~l2).index()]) {
                 res = false;
                 break;
             }
-            if (!m_visited[l2.index()])
+            if (!visited[l2.index()])
                 r.push_back(l2);
         }
 
         for (unsigned i = 0; i < sz1; ++i) {
             literal l1 = c1[i];
-            m_visited[l1.index()] = false;
+            visited[l1.index()] = false;
         }
         return res;
     }
@@ -1900,7 +1905,16 @@ namespace sat {
         }
     }
 
-    bool simplifier::try_eliminate(bool_var v) {
+    /**
+       \brief Check whether v can be eliminated by resolution without increasing
+       the number of clauses. The clauses of v are collected in pos_cls and neg_cls,
+       and the work done is added to cost. num_clauses is the number of clauses
+       used for the cutoffs.
+       The check only reads the clauses of v, so it can run concurrently
+       for variables that do not share clauses.
+    */
+    bool simplifier::can_eliminate(bool_var v, unsigned num_clauses, clause_wrapper_vector & pos_cls, clause_wrapper_vector & neg_cls,
+                                   literal_vector & new_cls, svector<char> & visited, int & cost) {
         if (value(v) != l_undef)
             return false;
 
@@ -1932,29 +1946,30 @@ namespace sat {
 
         TRACE("sat_simplifier", tout << v << " num_pos: " << num_pos << " neg_pos: " << num_neg << " before_lits: " << before_lits << "\n";);
 
-        if (num_pos >= m_res_occ_cutoff3 && num_neg >= m_res_occ_cutoff3 && before_lits > m_res_lit_cutoff3 && s.m_clauses.size() > m_res_cls_cutoff2)
+        if (num_pos >= m_res_occ_cutoff3 && num_neg >= m_res_occ_cutoff3 && before_lits > m_res_lit_cutoff3 && num_clauses > m_res_cls_cutoff2)
             return false;
         if (num_pos >= m_res_occ_cutoff2 && num_neg >= m_res_occ_cutoff2 && before_lits > m_res_lit_cutoff2 &&
-            s.m_clauses.size() > m_res_cls_cutoff1 && s.m_clauses.size() <= m_res_cls_cutoff2)
+            num_clauses > m_res_cls_cutoff1 && num_clauses <= m_res_cls_cutoff2)
             return false;
         if (num_pos >= m_res_occ_cutoff1 && num_neg >= m_res_occ_cutoff1 && before_lits > m_res_lit_cutoff1 &&
-            s.m_clauses.size() <= m_res_cls_cutoff1)
+            num_clauses <= m_res_cls_cutoff1)
             return false;
 
-        m_pos_cls.reset();
-        m_neg_cls.reset();
-        collect_clauses(pos_l, m_pos_cls);
-        collect_clauses(neg_l, m_neg_cls);
+        pos_cls.reset();
+        neg_cls.reset();
+        collect_clauses(pos_l, pos_cls);
+        collect_clauses(neg_l, neg_cls);
 
         TRACE("sat_simplifier", tout << "collecting number of after_clauses\n";);
         unsigned before_clauses = num_pos + num_neg;
         unsigned after_clauses  = 0;
-        for (clause_wrapper& c1 : m_pos_cls) {
-            for (clause_wrapper& c2 : m_neg_cls) {
-                m_new_cls.reset();
-                if (resolve(c1, c2, pos_l, m_new_cls)) {
+        for (clause_wrapper& c1 : pos_cls) {
+            for (clause_wrapper& c2 : neg_cls) {
+                new_cls.reset();
+                cost += c1.size() + c2.size();
+                if (resolve(c1, c2, pos_l, new_cls, visited)) {
                     TRACE("sat_simplifier", tout << c1 << "\n" << c2 << "\n-->\n";
-                          for (literal l : m_new_cls) tout << l << " "; tout << "\n";);
+                          for (literal l : new_cls) tout << l << " "; tout << "\n";);
                     after_clauses++;
                     if (after_clauses > before_clauses) {
                         TRACE("sat_simplifier", tout << "too many after clauses: " << after_clauses << "\n";);
@@ -1964,9 +1979,35 @@ namespace sat {
             }
         }
         TRACE("sat_simplifier", tout << "eliminate " << v << ", before: " << before_clauses << " after: " << after_clauses << "\n";);
-        m_elim_counter -= num_pos * num_neg + before_lits;
+        cost += 3 * (num_pos * num_neg + before_lits);
+        return true;
+    }
 
-        m_elim_counter -= num_pos * num_neg + before_lits;
+    /**
+       \brief the cutoffs of can_eliminate only depend on the range of the number of clauses.
+    */
+    unsigned simplifier::cls_cutoff_range(unsigned num_clauses) const {
+        return num_clauses <= m_res_cls_cutoff1 ? 0 : (num_clauses <= m_res_cls_cutoff2 ? 1 : 2);
+    }
+
+    bool simplifier::try_eliminate(bool_var v) {
+        int cost = 0;
+        bool ok = can_eliminate(v, s.m_clauses.size(), m_pos_cls, m_neg_cls, m_new_cls, m_visited, cost);
+        m_elim_counter -= cost;
+        if (!ok)
+            return false;
+        resolve_eliminate(v);
+        return true;
+    }
+
+    /**
+       \brief eliminate v by resolving the clauses collected in m_pos_cls and m_neg_cls.
+    */
+    void simplifier::resolve_eliminate(bool_var v) {
+        literal pos_l(v, false);
+        literal neg_l(v, true);
+        clause_use_list & pos_occs = m_use_list.get(pos_l);
+        clause_use_list & neg_occs = m_use_list.get(neg_l);
 
         // eliminate variable
         ++s.m_stats.m_elim_var_res;
@@ -1975,7 +2016,6 @@ namespace sat {
         save_clauses(mc_entry, m_pos_cls);
         save_clauses(mc_entry, m_neg_cls);
         s.set_eliminated(v, true);
-        m_elim_counter -= num_pos * num_neg + before_lits;
 
         for (auto & c1 : m_pos_cls) {
             for (auto & c2 : m_neg_cls) {
@@ -2016,7 +2056,7 @@ namespace sat {
                     break;
                 }
                 if (s.inconsistent())
-                    return true;
+                    return;
             }
         }
         remove_bin_clauses(pos_l);
@@ -2025,7 +2065,6 @@ namespace sat {
         remove_clauses(neg_occs, neg_l);
         pos_occs.reset();
         neg_occs.reset();
-        return true;
     }
 
     struct simplifier::elim_var_report {
@@ -2049,24 +2088,146 @@ namespace sat {
         }
     };
 
+    void simplifier::eliminate(bool_var v, sat::elim_vars & elim_bdd) {
+        if (is_external(v)) {
+            // skip
+        }
+        else if (try_eliminate(v)) {
+            m_num_elim_vars++;
+        }
+        else if (elim_vars_bdd_enabled() && elim_bdd(v)) { 
+            m_num_elim_vars++;
+        }
+    }
+
+    /**
+       \brief Eliminate variables in batches.
+       A batch is the longest prefix of the remaining variables, in elimination order,
+       where no variable occurs in the clauses of another one and the clauses of
+       different variables share no variables. The checks of a batch run concurrently
+       on the threads of a pool. The batch is then eliminated sequentially in order,
+       using the results of the checks.
+       Resolvents of a variable only contain variables of its own clauses, so they
+       do not change the clauses of the other variables in the batch. The results
+       stay valid unless units were propagated or the number of clauses moved to a
+       different cutoff range, and in that case the remaining variables are checked
+       again. Variables are therefore eliminated exactly as by the sequential loop,
+       for any number of threads, and the cost of each check is charged once.
+    */
+    void simplifier::elim_vars_par(bool_var_vector const & vars, sat::elim_vars & elim_bdd) {
+        unsigned const max_batch = 1024;
+        worker_pool pool(m_elim_vars_threads);
+        unsigned num_threads = pool.size();
+        bool_var_vector batch, marked, occs;
+        svector<char> in_batch(s.num_vars(), false);
+        bool_vector candidate;
+        svector<int> costs;
+        vector<elim_scratch> scratch(num_threads);
+        for (auto & sc : scratch)
+            sc.m_visited.resize(2 * s.num_vars(), false);
+
+        auto collect_occs = [&](literal l) {
+            for (auto it = m_use_list.get(l).mk_iterator(); !it.at_end(); it.next()) 
+                for (literal l2 : it.curr())
+                    occs.push_back(l2.var());
+            for (auto const & w : get_wlist(~l)) 
+                if (w.is_binary_clause())
+                    occs.push_back(w.get_literal().var());
+        };
+
+        unsigned head = 0;
+        while (head < vars.size()) {
+            checkpoint();
+            if (m_elim_counter < 0)
+                break;
+            batch.reset();
+            for (; head < vars.size() && batch.size() < max_batch; ++head) {
+                bool_var v = vars[head];
+                if (is_external(v) || value(v) != l_undef) {
+                    batch.push_back(v);
+                    continue;
+                }
+                occs.reset();
+                occs.push_back(v);
+                collect_occs(literal(v, false));
+                collect_occs(literal(v, true));
+                bool clash = false;
+                for (bool_var w : occs)
+                    clash |= in_batch[w] != 0;
+                if (clash && !batch.empty())
+                    break;
+                for (bool_var w : occs) {
+                    if (!in_batch[w]) {
+                        in_batch[w] = true;
+                        marked.push_back(w);
+                    }
+                }
+                batch.push_back(v);
+            }
+            for (bool_var w : marked)
+                in_batch[w] = false;
+            marked.reset();
+
+            unsigned sz = batch.size();
+            unsigned num_clauses = s.m_clauses.size();
+            candidate.reset();
+            candidate.resize(sz, false);
+            costs.reset();
+            costs.resize(sz, 0);
+            pool.run([&](unsigned id) {
+                elim_scratch & sc = scratch[id];
+                for (unsigned i = id; i < sz; i += num_threads) 
+                    if (!is_external(batch[i])) 
+                        candidate[i] = can_eliminate(batch[i], num_clauses, sc.m_pos_cls, sc.m_neg_cls, sc.m_new_cls, sc.m_visited, costs[i]);
+            });
+
+            unsigned trail_sz = s.m_trail.size();
+            unsigned range = cls_cutoff_range(num_clauses);
+            for (unsigned i = 0; i < sz; ++i) {
+                checkpoint();
+                if (m_elim_counter < 0)
+                    return;
+                bool_var v = batch[i];
+                bool eliminated = false;
+                if (is_external(v)) 
+                    continue;
+                if (s.m_trail.size() != trail_sz || cls_cutoff_range(s.m_clauses.size()) != range) {
+                    eliminated = try_eliminate(v);
+                }
+                else {
+                    m_elim_counter -= costs[i];
+                    if (candidate[i]) {
+                        m_pos_cls.reset();
+                        m_neg_cls.reset();
+                        collect_clauses(literal(v, false), m_pos_cls);
+                        collect_clauses(literal(v, true), m_neg_cls);
+                        resolve_eliminate(v);
+                        eliminated = true;
+                    }
+                }
+                if (eliminated || (elim_vars_bdd_enabled() && elim_bdd(v)))
+                    m_num_elim_vars++;
+                if (s.inconsistent())
+                    return;
+            }
+        }
+    }
+
     void simplifier::elim_vars() {
         if (!elim_vars_enabled()) return;
         elim_var_report rpt(*this);
         bool_var_vector vars;
         order_vars_for_elim(vars);
         sat::elim_vars elim_bdd(*this);
-        for (bool_var v : vars) {
-            checkpoint();
-            if (m_elim_counter < 0) 
-                break;
-            if (is_external(v)) {
-                // skip
-            }
-            else if (try_eliminate(v)) {
-                m_num_elim_vars++;
-            }
-            else if (elim_vars_bdd_enabled() && elim_bdd(v)) { 
-                m_num_elim_vars++;
+        if (m_elim_vars_threads > 1) {
+            elim_vars_par(vars, elim_bdd);
+        }
+        else {
+            for (bool_var v : vars) {
+                checkpoint();
+                if (m_elim_counter < 0) 
+                    break;
+                eliminate(v, elim_bdd);
             }
         }
 
@@ -2102,6 +2263,7 @@ namespace sat {
         m_elim_vars               = p.elim_vars();
         m_elim_vars_bdd           = false && p.elim_vars_bdd(); // buggy?
         m_elim_vars_bdd_delay     = p.elim_vars_bdd_delay();
+        m_elim_vars_threads       = std::max(1u, p.elim_vars_threads());
         m_incremental_mode        = s.get_config().m_incremental && !p.override_incremental();
     }
 
@@ -37,6 +37,7 @@ namespace pb {
 
 namespace sat {
     class solver;
+    class elim_vars;
 
     class use_list {
         vector<clause_use_list> m_use_list;
@@ -103,6 +104,7 @@ namespace sat {
         bool                   m_elim_vars;
         bool                   m_elim_vars_bdd;
         unsigned               m_elim_vars_bdd_delay;
+        unsigned               m_elim_vars_threads;
 
         // stats
         unsigned               m_num_bce;
@@ -197,12 +199,25 @@ namespace sat {
         clause_wrapper_vector m_neg_cls;
         literal_vector m_new_cls;
         bool resolve(clause_wrapper const & c1, clause_wrapper const & c2, literal l, literal_vector & r);
+        static bool resolve(clause_wrapper const & c1, clause_wrapper const & c2, literal l, literal_vector & r, svector<char> & visited);
         void save_clauses(model_converter::entry & mc_entry, clause_wrapper_vector const & cs);
         void add_non_learned_binary_clause(literal l1, literal l2);
         void remove_bin_clauses(literal l);
         void remove_clauses(clause_use_list const & cs, literal l);
+        struct elim_scratch {
+            clause_wrapper_vector m_pos_cls;
+            clause_wrapper_vector m_neg_cls;
+            literal_vector        m_new_cls;
+            svector<char>         m_visited;
+        };
+        bool can_eliminate(bool_var v, unsigned num_clauses, clause_wrapper_vector & pos_cls, clause_wrapper_vector & neg_cls,
+                           literal_vector & new_cls, svector<char> & visited, int & cost);
+        unsigned cls_cutoff_range(unsigned num_clauses) const;
         bool try_eliminate(bool_var v);
+        void resolve_eliminate(bool_var v);
+        void eliminate(bool_var v, sat::elim_vars & elim_bdd);
         void elim_vars();
+        void elim_vars_par(bool_var_vector const & vars, sat::elim_vars & elim_bdd);
 
         struct blocked_cls_report;
         struct subsumption_report;
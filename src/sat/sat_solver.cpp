@@ -491,8 +491,8 @@ namespace sat {
         else if (has_variables_to_reinit(l1, l2))
             push_reinit_stack(l1, l2);
         m_stats.m_mk_bin_clause++;
-        get_wlist(~l1).push_back(watched(l2, redundant));
-        get_wlist(~l2).push_back(watched(l1, redundant));
+        push_binary_watch(get_wlist(~l1), watched(l2, redundant));
+        push_binary_watch(get_wlist(~l2), watched(l1, redundant));
     }
 
     bool solver::has_variables_to_reinit(clause const& c) const {
@@ -1278,10 +1278,12 @@ namespace sat {
     // -----------------------
     lbool solver::check(unsigned num_lits, literal const* lits) {
         init_reason_unknown();
-        pop_to_base_level();
+        bool reused = reuse_trail(num_lits, lits);
+        if (!reused)
+            pop_to_base_level();
         m_stats.m_units = init_trail_size();
         IF_VERBOSE(2, verbose_stream() << "(sat.solver)\n";);
-        SASSERT(at_base_lvl());
+        SASSERT(reused || at_base_lvl());
 
         if (m_config.m_ddfw_search) {
             m_cleaner(true);
@@ -1309,10 +1311,13 @@ namespace sat {
         }
         try {
             init_search();
+            if (reused) 
+                m_search_lvl = scope_lvl();
             if (check_inconsistent()) return l_false;
             propagate(false);
             if (check_inconsistent()) return l_false;
-            init_assumptions(num_lits, lits);
+            if (!reused)
+                init_assumptions(num_lits, lits);
             propagate(false);
             if (check_inconsistent()) return l_false;
             if (m_config.m_force_cleanup) do_cleanup(true);
@@ -1471,7 +1476,7 @@ namespace sat {
 #define IS_MAIN_SOLVER(i)  (i == main_solver_offset)
 
         sat::parallel par(*this);
-        par.reserve(num_threads, 1 << 12);
+        par.reserve(num_threads, m_config.m_par_buffer_size);
         par.init_solvers(*this, num_extra_solvers);
         for (unsigned i = 0; i < ls.size(); ++i) {
             par.push_child(ls[i]->rlimit());
@@ -1554,6 +1559,15 @@ namespace sat {
             th.join();
         }
         
+        IF_VERBOSE(1, 
+                   for (int i = 0; i <= num_extra_solvers; ++i) {
+                       stats const& st = IS_AUX_SOLVER(i) ? par.get_solver(i).m_stats : m_stats;
+                       verbose_stream() << "(sat.parallel :thread " << i 
+                                        << " :exported " << st.m_par_exported 
+                                        << " :imported " << st.m_par_imported 
+                                        << " :filtered " << st.m_par_filtered 
+                                        << " :dropped " << st.m_par_dropped << ")\n";
+                   });
         if (IS_AUX_SOLVER(finished_id)) {
             m_stats = par.get_solver(finished_id).m_stats;
         }
@@ -1817,6 +1831,44 @@ namespace sat {
         SASSERT(m_search_lvl == 1);
     }
 
+    /**
+       \brief Reuse the assumption level of the previous check if its assumptions
+       are a prefix of the new assumptions. Backtrack to the assumption level,
+       which keeps the literals propagated from the common prefix, and assign
+       the remaining assumptions on top.
+       Return false if the trail cannot be reused. 
+    */
+    bool solver::reuse_trail(unsigned num_lits, literal const* lits) {
+        unsigned n = m_assumptions.size();
+        if (!m_config.m_reuse_trail || m_ext || m_par || inconsistent())
+            return false;
+        if (m_search_lvl != 1 || scope_lvl() == 0 || n > num_lits)
+            return false;
+        // the assumption level is fully propagated unless the previous check stopped at it.
+        if (scope_lvl() == 1 && m_qhead < m_trail.size())
+            return false;
+        if (m_config.m_ddfw_search || m_config.m_prob_search || m_config.m_local_search ||
+            m_config.m_num_threads > 1 || m_config.m_local_search_threads > 0 || m_config.m_ddfw_threads > 0 ||
+            m_config.m_enable_pre_simplify || m_config.m_force_cleanup)
+            return false;
+        for (unsigned i = 0; i < n; ++i)
+            if (m_assumptions[i] != lits[i])
+                return false;
+
+        pop(scope_lvl() - 1);
+        unsigned num_reused = m_trail.size() - m_scopes[0].m_trail_lim;
+        ++m_stats.m_trail_reuse;
+        m_stats.m_trail_reused += num_reused;
+        IF_VERBOSE(10, verbose_stream() << "(sat.reuse-trail :assumptions " << n << " :literals " << num_reused << ")\n";);
+        TRACE("sat", tout << "reuse trail " << literal_vector(n, lits) << " new: " << literal_vector(num_lits - n, lits + n) << "\n";);
+
+        for (unsigned i = n; !inconsistent() && i < num_lits; ++i) {
+            add_assumption(lits[i]);
+            assign_scoped(lits[i]);
+        }
+        return true;
+    }
+
     void solver::update_min_core() {
         if (!m_min_core_valid || m_core.size() < m_min_core.size()) {
             m_min_core.reset();
@@ -4757,10 +4809,16 @@ namespace sat {
         st.update("sat subs resolution dyn", m_dyn_sub_res);
         st.update("sat blocked correction sets", m_blocked_corr_sets);
         st.update("sat units", m_units);
+        st.update("sat trail reuse", m_trail_reuse);
+        st.update("sat trail reused literals", m_trail_reused);
         st.update("sat elim bool vars res", m_elim_var_res);
         st.update("sat elim bool vars bdd", m_elim_var_bdd);
         st.update("sat backjumps", m_backjumps);
         st.update("sat backtracks", m_backtracks);
+        st.update("sat par exported", m_par_exported);
+        st.update("sat par imported", m_par_imported);
+        st.update("sat par filtered", m_par_filtered);
+        st.update("sat par dropped", m_par_dropped);
     }
 
     void stats::reset() {
@@ -76,8 +76,14 @@ namespace sat {
         unsigned m_elim_var_res;
         unsigned m_elim_var_bdd;
         unsigned m_units;
+        unsigned m_trail_reuse;
+        unsigned m_trail_reused;
         unsigned m_backtracks;
         unsigned m_backjumps;
+        unsigned m_par_exported;
+        unsigned m_par_imported;
+        unsigned m_par_filtered;
+        unsigned m_par_dropped;
         stats() { reset(); }
         void reset();
         void collect_statistics(statistics & st) const;
@@ -516,6 +522,7 @@ namespace sat {
         bool           m_min_core_valid { false };
         void init_reason_unknown() { m_reason_unknown = "no reason given"; }
         void init_assumptions(unsigned num_lits, literal const* lits);
+        bool reuse_trail(unsigned num_lits, literal const* lits);
         void reassert_min_core();
         void update_min_core();
         void resolve_weighted();
@@ -564,6 +571,7 @@ namespace sat {
         void save_psm();
         void gc_half(char const * st_name);
         void gc_dyn_psm();
+        void gc_tiered();
         bool activate_frozen_clause(clause & c);
         unsigned psm(clause const & c) const;
         bool can_delete(clause const & c) const;
@@ -123,14 +123,16 @@ public:
         ast_translation tr(m, dst_m);
         m_solver.pop_to_base_level();
         inc_sat_solver* result = alloc(inc_sat_solver, dst_m, p, is_incremental());
+        // a copy within the same manager keeps the learned clauses.
+        bool copy_learned = &m == &dst_m;
         auto* ext = get_euf();
         if (ext) {
             auto& si = result->m_goal2sat.si(dst_m, m_params, result->m_solver, result->m_map, result->m_dep2asm, is_incremental());
             euf::solver::scoped_set_translate st(*ext, dst_m, si);  
-            result->m_solver.copy(m_solver);
+            result->m_solver.copy(m_solver, copy_learned);
         }        
         else {
-            result->m_solver.copy(m_solver);
+            result->m_solver.copy(m_solver, copy_learned);
         }
         result->m_fmls_head = m_fmls_head;
         for (expr* f : m_fmls) result->m_fmls.push_back(tr(f));
@@ -143,7 +145,9 @@ public:
         if (m_mcs.back()) result->m_mcs.push_back(m_mcs.back()->translate(tr));
         if (m_sat_mc) result->m_sat_mc = dynamic_cast<sat2goal::mc*>(m_sat_mc->translate(tr));
         result->m_has_uninterpreted = m_has_uninterpreted;
-        // copy m_bb_rewriter?
+        // bit-vector constants in new assertions are blasted to the bits of the source.
+        if (m_bb_rewriter && result->m_bb_rewriter) 
+            result->m_bb_rewriter->copy_translation(*m_bb_rewriter, tr);
         result->m_internalized_converted = m_internalized_converted;
         return result;
     }
@@ -181,7 +185,10 @@ public:
     }
 
     lbool check_sat_core(unsigned sz, expr * const * assumptions) override {
-        m_solver.pop_to_base_level();
+        // the SAT solver stays at the assumption level of the previous check
+        // when only literal assumptions change, so it can reuse the trail.
+        if (m_solver.inconsistent())
+            m_solver.pop_to_base_level();
         m_core.reset();
         if (m_solver.inconsistent()) return l_false;
         expr_ref_vector _assumptions(m);
@@ -204,8 +211,10 @@ public:
         m_dep2asm.reset();
         lbool r = internalize_formulas();
         if (r != l_true) return r;
-        r = internalize_assumptions(sz, _assumptions.data());
-        if (r != l_true) return r;
+        if (!internalize_literal_assumptions(sz, _assumptions.data())) {
+            r = internalize_assumptions(sz, _assumptions.data());
+            if (r != l_true) return r;
+        }
 
         init_reason_unknown();
         m_internalized_converted = false;
@@ -770,6 +779,38 @@ private:
         return res;
     }
 
+    /**
+       \brief Map assumptions that are literals over atoms that are already
+       internalized directly, without preprocessing them as a goal.
+       Return false if some assumption requires internalization.
+    */
+    bool internalize_literal_assumptions(unsigned sz, expr* const* asms) {
+        if (!m_weights.empty())
+            return false;
+        auto add = [&](expr* a) {
+            expr* e = a;
+            bool sign = m.is_not(a, e);
+            if (!is_uninterp_const(e))
+                return false;
+            sat::bool_var v = m_map.to_bool_var(e);
+            if (v == sat::null_bool_var || m_solver.was_eliminated(v))
+                return false;
+            m_dep2asm.insert(a, sat::literal(v, sign));
+            return true;
+        };
+        bool ok = true;
+        for (unsigned i = 0; ok && i < sz; ++i)
+            ok = add(asms[i]);
+        for (unsigned i = 0; ok && i < get_num_assumptions(); ++i)
+            ok = add(get_assumption(i));
+        if (!ok) {
+            m_dep2asm.reset();
+            return false;
+        }
+        extract_assumptions(sz, asms);
+        return true;
+    }
+
     lbool internalize_vars(expr_ref_vector const& vars, sat::bool_var_vector& bvars) {
         for (expr* v : vars) {
             internalize_var(v, bvars);
@@ -40,6 +40,21 @@ namespace sat {
         return false;                                           
     }
 
+    /**
+       \brief Add a binary watch after the binary watches at the front of the list.
+       Binary watches are then visited first during propagation, before
+       the watches that require accessing clause memory.
+    */
+    void push_binary_watch(watch_list & wlist, watched const& w) {
+        SASSERT(w.is_binary_clause());
+        wlist.push_back(w);
+        unsigned i = wlist.size() - 1;
+        while (i > 0 && !wlist[i - 1].is_binary_clause())
+            --i;
+        if (i + 1 < wlist.size())
+            std::swap(wlist[i], wlist.back());
+    }
+
     watched* find_binary_watch(watch_list & wlist, literal l) {
         for (watched& w : wlist) {
             if (w.is_binary_clause() && w.get_literal() == l) return &w;
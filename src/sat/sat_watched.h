@@ -133,6 +133,7 @@ namespace sat {
 
     typedef vector<watched> watch_list;
 
+    void push_binary_watch(watch_list & wlist, watched const& w);
     watched* find_binary_watch(watch_list & wlist, literal l);
     watched const* find_binary_watch(watch_list const & wlist, literal l);
     bool erase_clause_watch(watch_list & wlist, clause_offset c);
@@ -32,7 +32,8 @@ namespace q {
         m_cost_function(m),
         m_new_gen_function(m),
         m_parser(m),
-        m_evaluator(m),
+        m_cost(m),
+        m_new_gen(m),
         m_subst(m)
     {
         init_parser_vars();
@@ -50,6 +51,8 @@ namespace q {
             warning_msg("invalid new_gen function '%s', switching to default one", m_params.m_qi_new_gen.c_str());
             VERIFY(m_parser.parse_string("cost", m_new_gen_function));
         }
+        m_cost.set(m_cost_function);
+        m_new_gen.set(m_new_gen_function);
         m_eager_cost_threshold = m_params.m_qi_eager_threshold;
     }
 
@@ -110,14 +113,14 @@ namespace q {
 
     float queue::get_cost(fingerprint& f) {
         set_values(f, 0);
-        float r = m_evaluator(m_cost_function, m_vals.size(), m_vals.data());
-        f.c->m_stat->update_max_cost(r);
+        float r = m_cost(m_vals.size(), m_vals.data());
+        f.c->m_stat->update_cost(r);
         return r;
     }
 
     unsigned queue::get_new_gen(fingerprint& f, float cost) {
         set_values(f, cost);
-        float r = m_evaluator(m_new_gen_function, m_vals.size(), m_vals.data());
+        float r = m_new_gen(m_vals.size(), m_vals.data());
         return std::max(f.m_max_generation + 1, static_cast<unsigned>(r));
     }
 
@@ -23,6 +23,7 @@ Revision History:
 #include<signal.h>
 #include "util/timeout.h"
 #include "util/mutex.h"
+#include "util/mapped_file.h"
 #include "parsers/smt2/smt2parser.h"
 #include "muz/fp/dl_cmds.h"
 #include "cmd_context/extra_cmds/dbg_cmds.h"
@@ -134,12 +135,19 @@ unsigned read_smtlib2_commands(char const * file_name) {
 
     bool result = true;
     if (file_name) {
-        std::ifstream in(file_name);
-        if (in.bad() || in.fail()) {
-            std::cerr << "(error \"failed to open file '" << file_name << "'\")" << std::endl;
-            exit(ERR_OPEN_FILE);
+        mapped_file in(file_name, false);
+        if (in.is_open()) {
+            result = parse_smt2_commands(ctx, in.begin(), in.end());
+        }
+        else {
+            // input that cannot be mapped, such as a pipe, is streamed
+            std::ifstream is(file_name);
+            if (is.bad() || is.fail()) {
+                std::cerr << "(error \"failed to open file '" << file_name << "'\")" << std::endl;
+                exit(ERR_OPEN_FILE);
+            }
+            result = parse_smt2_commands(ctx, is);
         }
-        result = parse_smt2_commands(ctx, in);
     }
     else {
         result = parse_smt2_commands(ctx, std::cin, true);
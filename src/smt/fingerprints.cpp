@@ -20,38 +20,6 @@ Revision History:
 
 namespace smt {
 
-    fingerprint::fingerprint(region & r, void * d, unsigned d_h, expr* def, unsigned n, enode * const * args):
-        m_data(d), 
-        m_data_hash(d_h),
-        m_def(def),
-        m_num_args(n), 
-        m_args(nullptr) {
-        m_args = new (r) enode*[n];
-        memcpy(m_args, args, sizeof(enode*) * n);
-    }
-
-    bool fingerprint_set::fingerprint_eq_proc::operator()(fingerprint const * f1, fingerprint const * f2) const {
-        if (f1->get_data() != f2->get_data()) 
-            return false;
-        if (f1->get_num_args() != f2->get_num_args())
-            return false;
-        unsigned n = f1->get_num_args();
-        for(unsigned i = 0; i < n; i++)
-            if (f1->get_arg(i) != f2->get_arg(i))
-                return false;
-        return true;
-    }
-
-    fingerprint * fingerprint_set::mk_dummy(void * data, unsigned data_hash, unsigned num_args, enode * const * args) {
-        m_tmp.reset();
-        m_tmp.append(num_args, args);
-        m_dummy.m_data      = data;
-        m_dummy.m_data_hash = data_hash;
-        m_dummy.m_num_args  = num_args;
-        m_dummy.m_args      = m_tmp.data();
-        return &m_dummy;
-    }
-
     std::ostream& operator<<(std::ostream& out, fingerprint const& f) {
         out << f.get_data_hash() << " " << " num_args " << f.get_num_args() << " ";
         for (enode const * arg : f) {
@@ -62,37 +30,144 @@ namespace smt {
     }
 
     
+    unsigned fingerprint_set::hash(unsigned data_hash, unsigned num_args, enode * const * args) {
+        struct khasher {
+            unsigned operator()(unsigned h) const { return h; }
+        };
+        struct chasher {
+            enode * const * m_args;
+            unsigned operator()(unsigned, unsigned idx) const { return m_args[idx]->hash(); }
+        };
+        chasher ch{ args };
+        return get_composite_hash<unsigned, khasher, chasher>(data_hash, num_args, khasher(), ch);
+    }
+
+    bool fingerprint_set::bloom_contains(unsigned h) const {
+        if (m_bloom.empty())
+            return false;
+        unsigned b1 = h & m_bloom_mask, b2 = (h >> 16 ^ h * 0x9e3779b1) & m_bloom_mask;
+        return (m_bloom[b1 >> 6] >> (b1 & 63) & 1) && (m_bloom[b2 >> 6] >> (b2 & 63) & 1);
+    }
+
+    void fingerprint_set::bloom_insert(unsigned h) {
+        unsigned b1 = h & m_bloom_mask, b2 = (h >> 16 ^ h * 0x9e3779b1) & m_bloom_mask;
+        m_bloom[b1 >> 6] |= 1ull << (b1 & 63);
+        m_bloom[b2 >> 6] |= 1ull << (b2 & 63);
+    }
+
+    /**
+       \brief The filter has 4 bits per table cell, that is,
+       at least 8 bits per fingerprint.
+    */
+    void fingerprint_set::rebuild_bloom() {
+        unsigned num_bits = std::max(64u, 4 * m_table.size());
+        m_bloom.reset();
+        m_bloom.resize(num_bits / 64, 0);
+        m_bloom_mask = num_bits - 1;
+        m_bloom_stale = 0;
+        for (unsigned c : m_cells)
+            bloom_insert(m_table[c].m_hash);
+    }
+
+    void fingerprint_set::expand_table() {
+        unsigned capacity = std::max(64u, 2 * m_table.size());
+        svector<cell> old_table;
+        old_table.swap(m_table);
+        m_table.resize(capacity, cell{ 0, UINT_MAX });
+        m_mask = capacity - 1;
+        // reinsert in insertion order, so that cells can be cleared in reverse order.
+        for (unsigned i = 0; i < m_cells.size(); ++i) {
+            unsigned h = old_table[m_cells[i]].m_hash;
+            unsigned pos = h & m_mask;
+            while (m_table[pos].m_idx != UINT_MAX)
+                pos = (pos + 1) & m_mask;
+            m_table[pos] = cell{ h, i };
+            m_cells[i] = pos;
+        }
+        rebuild_bloom();
+    }
+
+    /**
+       \brief Return the position of the cell with a fingerprint equal to (data args), 
+       or the position of the free cell where it would be inserted.
+    */
+    unsigned fingerprint_set::find(void * data, unsigned h, unsigned num_args, enode * const * args) const {
+        unsigned pos = h & m_mask;
+        while (true) {
+            cell const & c = m_table[pos];
+            if (c.m_idx == UINT_MAX)
+                return pos;
+            if (c.m_hash == h) {
+                fingerprint const * f = m_fingerprints[c.m_idx];
+                if (f->get_data() == data && f->get_num_args() == num_args &&
+                    std::equal(args, args + num_args, f->get_args()))
+                    return pos;
+            }
+            pos = (pos + 1) & m_mask;
+        }
+    }
+
+    bool fingerprint_set::contains_core(void * data, unsigned h, unsigned num_args, enode * const * args) const {
+        return bloom_contains(h) && m_table[find(data, h, num_args, args)].m_idx != UINT_MAX;
+    }
+
+    /**
+       \brief Store the roots of args in m_tmp. Return false if args are already roots.
+    */
+    bool fingerprint_set::to_roots(unsigned num_args, enode * const * args) {
+        m_tmp.reset();
+        bool change = false;
+        for (unsigned i = 0; i < num_args; i++) {
+            enode * r = args[i]->get_root();
+            change |= r != args[i];
+            m_tmp.push_back(r);
+        }
+        return change;
+    }
+
     fingerprint * fingerprint_set::insert(void * data, unsigned data_hash, unsigned num_args, enode * const * args, expr* def) {
-        fingerprint * d = mk_dummy(data, data_hash, num_args, args);
-        if (m_set.contains(d)) 
-            return nullptr;
-        for (unsigned i = 0; i < num_args; i++)
-            d->m_args[i] = d->m_args[i]->get_root();
-        if (m_set.contains(d)) {
-            TRACE("fingerprint_bug", tout << "failed: " << *d;);
+        unsigned h = hash(data_hash, num_args, args);
+        if (contains_core(data, h, num_args, args))
             return nullptr;
+        if (to_roots(num_args, args)) {
+            args = m_tmp.data();
+            h = hash(data_hash, num_args, args);
+            if (contains_core(data, h, num_args, args)) {
+                TRACE("fingerprint_bug", tout << "failed: " << data_hash << " " << num_args << "\n";);
+                return nullptr;
+            }
         }
-        TRACE("fingerprint_bug", tout << "inserting @" << m_scopes.size() << " " << *d;);
-        fingerprint * f = new (m_region) fingerprint(m_region, data, data_hash, def, num_args, d->m_args);
+        if (2 * (m_fingerprints.size() + 1) > m_table.size())
+            expand_table();
+        unsigned pos = find(data, h, num_args, args);
+        SASSERT(m_table[pos].m_idx == UINT_MAX);
+        void * mem = m_region.allocate(sizeof(fingerprint) + num_args * sizeof(enode*));
+        enode ** f_args = reinterpret_cast<enode**>(static_cast<char*>(mem) + sizeof(fingerprint));
+        std::copy(args, args + num_args, f_args);
+        fingerprint * f = new (mem) fingerprint(data, data_hash, def, num_args, f_args);
+        TRACE("fingerprint_bug", tout << "inserting @" << m_scopes.size() << " " << *f;);
+        m_table[pos] = cell{ h, m_fingerprints.size() };
+        m_cells.push_back(pos);
         m_fingerprints.push_back(f);
         m_defs.push_back(def);
-        m_set.insert(f);
+        bloom_insert(h);
         return f;
     }
 
     bool fingerprint_set::contains(void * data, unsigned data_hash, unsigned num_args, enode * const * args) {
-        fingerprint * d = mk_dummy(data, data_hash, num_args, args);
-        if (m_set.contains(d)) 
-            return true;
-        for (unsigned i = 0; i < num_args; i++)
-            d->m_args[i] = d->m_args[i]->get_root();
-        if (m_set.contains(d))
+        if (contains_core(data, hash(data_hash, num_args, args), num_args, args))
             return true;
-        return false;
+        if (!to_roots(num_args, args))
+            return false;
+        return contains_core(data, hash(data_hash, num_args, m_tmp.data()), num_args, m_tmp.data());
     }
     
     void fingerprint_set::reset() {
-        m_set.reset();
+        m_table.reset();
+        m_mask = 0;
+        m_bloom.reset();
+        m_bloom_stale = 0;
+        m_cells.reset();
         m_fingerprints.reset();
         m_defs.reset();
     }
@@ -107,17 +182,20 @@ namespace smt {
         unsigned new_lvl  = lvl - num_scopes;
         unsigned old_size = m_scopes[new_lvl];
         unsigned size     = m_fingerprints.size();
-        for (unsigned i = old_size; i < size; i++) 
-            m_set.erase(m_fingerprints[i]);
+        for (unsigned i = size; i-- > old_size; ) 
+            m_table[m_cells[i]].m_idx = UINT_MAX;
         m_fingerprints.shrink(old_size);
+        m_cells.shrink(old_size);
         m_defs.shrink(old_size);
         m_scopes.shrink(new_lvl);
+        m_bloom_stale += size - old_size;
+        if (m_bloom_stale > old_size && m_bloom_stale > 1024)
+            rebuild_bloom();
         TRACE("fingerprint_bug", tout << "pop @" << m_scopes.size() << "\n";);
     }
 
     void fingerprint_set::display(std::ostream & out) const {
         out << "fingerprints:\n";
-        SASSERT(m_set.size() == m_fingerprints.size());
         for (fingerprint const * f : m_fingerprints) {
             out << f->get_data() << " " << *f;
         }
@@ -32,9 +32,9 @@ namespace smt {
         enode**       m_args{ nullptr };
 
         friend class fingerprint_set;
-        fingerprint() {}
+        fingerprint(void * d, unsigned d_hash, expr* def, unsigned n, enode ** args):
+            m_data(d), m_data_hash(d_hash), m_def(def), m_num_args(n), m_args(args) {}
     public:
-        fingerprint(region & r, void * d, unsigned d_hash, expr* def, unsigned n, enode * const * args);
         void * get_data() const { return m_data; }
         expr * get_def() const { return m_def; }
         unsigned get_data_hash() const { return m_data_hash; }
@@ -46,31 +46,44 @@ namespace smt {
         friend std::ostream& operator<<(std::ostream& out, fingerprint const& f);
     };
     
+    /**
+       \brief Set of fingerprints of quantifier instances.
+
+       The index is an open addressing table of (hash, fingerprint index) cells
+       with linear probing. Fingerprints are only removed when scopes are popped,
+       that is, in reverse insertion order. Clearing their cells in that order
+       restores the table to its state before the insertions, so removal
+       does not need tombstones, hashing or comparisons.
+       A Bloom filter over the same hash codes answers most lookups of new
+       fingerprints without probing the table. Bits of removed fingerprints
+       are only cleared when the filter is rebuilt.
+    */
     class fingerprint_set {
-        
-        struct fingerprint_khasher {
-            unsigned operator()(fingerprint const * f) const { return f->get_data_hash(); }
+        struct cell {
+            unsigned m_hash;
+            unsigned m_idx;   // index into m_fingerprints, UINT_MAX if the cell is free
         };
-        struct fingerprint_chasher {
-            unsigned operator()(fingerprint const * f, unsigned idx) const { return f->get_arg(idx)->hash(); }
-        };
-        struct fingerprint_hash_proc {
-            unsigned operator()(fingerprint const * f) const {
-                return get_composite_hash<fingerprint *, fingerprint_khasher, fingerprint_chasher>(const_cast<fingerprint*>(f), f->get_num_args());
-            }
-        };
-        struct fingerprint_eq_proc { bool operator()(fingerprint const * f1, fingerprint const * f2) const; };
-        typedef ptr_hashtable<fingerprint, fingerprint_hash_proc, fingerprint_eq_proc> set;
 
         region &                 m_region;
-        set                      m_set;
+        svector<cell>            m_table;
+        unsigned                 m_mask{ 0 };
+        svector<uint64_t>        m_bloom;
+        unsigned                 m_bloom_mask{ 0 };
+        unsigned                 m_bloom_stale{ 0 };
         ptr_vector<fingerprint>  m_fingerprints;
+        unsigned_vector          m_cells;   // position in m_table of each fingerprint
         expr_ref_vector          m_defs;
         unsigned_vector          m_scopes;
         ptr_vector<enode>        m_tmp;
-        fingerprint              m_dummy;
 
-        fingerprint * mk_dummy(void * data, unsigned data_hash, unsigned num_args, enode * const * args);
+        static unsigned hash(unsigned data_hash, unsigned num_args, enode * const * args);
+        bool bloom_contains(unsigned h) const;
+        void bloom_insert(unsigned h);
+        void rebuild_bloom();
+        void expand_table();
+        unsigned find(void * data, unsigned h, unsigned num_args, enode * const * args) const;
+        bool contains_core(void * data, unsigned h, unsigned num_args, enode * const * args) const;
+        bool to_roots(unsigned num_args, enode * const * args);
 
     public:
         fingerprint_set(ast_manager& m, region & r): m_region(r), m_defs(m) {}
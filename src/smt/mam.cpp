@@ -1801,13 +1801,13 @@ namespace {
         approx_set plbls;
         enode * first = n;
         do {
-            lbls  |= n->get_lbls();
-            plbls |= n->get_plbls();
+            lbls  |= m_context.get_lbls(n);
+            plbls |= m_context.get_plbls(n);
             n = n->get_next();
         }
         while (first != n);
-        SASSERT(n->get_root()->get_lbls()  == lbls);
-        SASSERT(n->get_root()->get_plbls() == plbls);
+        SASSERT(m_context.get_lbls(n->get_root())  == lbls);
+        SASSERT(m_context.get_plbls(n->get_root()) == plbls);
         return true;
     }
 #endif
@@ -2146,7 +2146,7 @@ namespace {
                 goto non_depth1;
             }
             r = n->get_root();
-            if (m_use_filters && r->get_plbls().empty_intersection(c->m_lbl_set))
+            if (m_use_filters && m_context.get_plbls(r).empty_intersection(c->m_lbl_set))
                 return nullptr;
             if (r->get_num_parents() == 0)
                 return nullptr;
@@ -2227,7 +2227,7 @@ namespace {
         else {
             out << "#" << n->get_expr_id() << ", root: " << n->get_root()->get_expr_id();
             if (m_use_filters)
-                out << ", lbls: " << n->get_root()->get_lbls() << " ";
+                out << ", lbls: " << m_context.get_lbls(n->get_root()) << " ";
             out << "\n";
             out << mk_pp(n->get_expr(), m) << "\n";
         }
@@ -2424,14 +2424,14 @@ namespace {
         case CFILTER:
         case FILTER:
             m_n1 = m_registers[static_cast<const filter *>(m_pc)->m_reg]->get_root();
-            if (static_cast<const filter *>(m_pc)->m_lbl_set.empty_intersection(m_n1->get_lbls()))
+            if (static_cast<const filter *>(m_pc)->m_lbl_set.empty_intersection(m_context.get_lbls(m_n1)))
                 goto backtrack;
             m_pc = m_pc->m_next;
             goto main_loop;
 
         case PFILTER:
             m_n1 = m_registers[static_cast<const filter *>(m_pc)->m_reg]->get_root();
-            if (static_cast<const filter *>(m_pc)->m_lbl_set.empty_intersection(m_n1->get_plbls()))
+            if (static_cast<const filter *>(m_pc)->m_lbl_set.empty_intersection(m_context.get_plbls(m_n1)))
                 goto backtrack;
             m_pc = m_pc->m_next;
             goto main_loop;
@@ -2607,10 +2607,10 @@ namespace {
 
 #define SET_VAR(IDX)                                                    \
             m_args[IDX] = m_registers[static_cast<const get_cgr *>(m_pc)->m_iregs[IDX]]; \
-            if (m_use_filters && static_cast<const get_cgr *>(m_pc)->m_lbl_set.empty_intersection(m_args[IDX]->get_root()->get_plbls())) { \
+            if (m_use_filters && static_cast<const get_cgr *>(m_pc)->m_lbl_set.empty_intersection(m_context.get_plbls(m_args[IDX]->get_root()))) { \
                 TRACE("trigger_bug", tout << "m_args[IDX]->get_root():\n" << mk_ismt2_pp(m_args[IDX]->get_root()->get_expr(), m) << "\n"; \
                       tout << "cgr  set: "; static_cast<const get_cgr *>(m_pc)->m_lbl_set.display(tout); tout << "\n"; \
-                      tout << "node set: "; m_args[IDX]->get_root()->get_plbls().display(tout); tout << "\n";); \
+                      tout << "node set: "; m_context.get_plbls(m_args[IDX]->get_root()).display(tout); tout << "\n";); \
                 goto backtrack;                                         \
             }
 
@@ -3170,10 +3170,10 @@ namespace {
         }
 
         void update_lbls(enode * n, unsigned elem) {
-            approx_set & r_lbls = n->get_root()->get_lbls();
-            if (!r_lbls.may_contain(elem)) {
-                m_trail_stack.push(value_trail<approx_set>(r_lbls));
-                r_lbls.insert(elem);
+            enode * r = n->get_root();
+            if (!m_context.get_lbls(r).may_contain(elem)) {
+                m_trail_stack.push(m_context.mk_lbls_trail(r));
+                m_context.get_lbls(r).insert(elem);
             }
         }
 
@@ -3192,8 +3192,8 @@ namespace {
                     update_lbls(app, h);
                     TRACE("mam_bug", tout << "updating labels of: #" << app->get_owner_id() << "\n";
                           tout << "new_elem: " << h << "\n";
-                          tout << "lbls:     " << app->get_lbls() << "\n";
-                          tout << "r.lbls:   " << app->get_root()->get_lbls() << "\n";);
+                          tout << "lbls:     " << m_context.get_lbls(app) << "\n";
+                          tout << "r.lbls:   " << m_context.get_lbls(app->get_root()) << "\n";);
                 }
             }
         }
@@ -3202,16 +3202,16 @@ namespace {
             unsigned num_args = app->get_num_args();
             for (unsigned i = 0; i < num_args; i++) {
                 enode * c            = app->get_arg(i);
-                approx_set & r_plbls = c->get_root()->get_plbls();
-                if (!r_plbls.may_contain(elem)) {
-                    m_trail_stack.push(value_trail<approx_set>(r_plbls));
-                    r_plbls.insert(elem);
+                enode * r            = c->get_root();
+                if (!m_context.get_plbls(r).may_contain(elem)) {
+                    m_trail_stack.push(m_context.mk_plbls_trail(r));
+                    m_context.get_plbls(r).insert(elem);
                     TRACE("trigger_bug", tout << "updating plabels of:\n" << mk_ismt2_pp(c->get_root()->get_expr(), m) << "\n";
                           tout << "new_elem: " << static_cast<unsigned>(elem) << "\n";
-                          tout << "plbls:    " << c->get_root()->get_plbls() << "\n";);
+                          tout << "plbls:    " << m_context.get_plbls(c->get_root()) << "\n";);
                     TRACE("mam_bug", tout << "updating plabels of: #" << c->get_root()->get_owner_id() << "\n";
                           tout << "new_elem: " << static_cast<unsigned>(elem) << "\n";
-                          tout << "plbls:    " << c->get_root()->get_plbls() << "\n";);
+                          tout << "plbls:    " << m_context.get_plbls(c->get_root()) << "\n";);
 
                 }
             }
@@ -3441,7 +3441,7 @@ namespace {
                     TRACE("mam_bug",
                           tout << "updating pc labels " << plbl->get_name() << " " <<
                           static_cast<unsigned>(n->get_lbl_hash()) << "\n";
-                          tout << "#" << n->get_owner_id() << " " << n->get_root()->get_lbls() << "\n";
+                          tout << "#" << n->get_owner_id() << " " << m_context.get_lbls(n->get_root()) << "\n";
                           tout << "relevant: " << m_context.is_relevant(n) << "\n";);
                     update_pc(m_lbl_hasher(plbl), n->get_lbl_hash(), new_path, qa, mp);
                     continue;
@@ -3562,7 +3562,7 @@ namespace {
                     // The file regression\acu.sx exposed this problem.
                     enode * curr_child = n->get_root();
 
-                    if (m_use_filters && curr_child->get_plbls().empty_intersection(filter))
+                    if (m_use_filters && m_context.get_plbls(curr_child).empty_intersection(filter))
                         continue;
 
 #ifdef _PROFILE_PATH_TREE
@@ -3671,8 +3671,8 @@ namespace {
         }
 
         void process_pp(enode * r1, enode * r2) {
-            approx_set & plbls1 = r1->get_plbls();
-            approx_set & plbls2 = r2->get_plbls();
+            approx_set plbls1 = m_context.get_plbls(r1);
+            approx_set plbls2 = m_context.get_plbls(r2);
             TRACE("incremental_matcher", tout << "pp: plbls1: " << plbls1 << ", plbls2: " << plbls2 << "\n";);
             TRACE("mam_info", tout << "pp: " << plbls1.size() * plbls2.size() << "\n";);
             if (!plbls1.empty() && !plbls2.empty()) {
@@ -3711,8 +3711,8 @@ namespace {
         }
 
         void process_pc(enode * r1, enode * r2) {
-            approx_set & plbls = r1->get_plbls();
-            approx_set & clbls = r2->get_lbls();
+            approx_set plbls = m_context.get_plbls(r1);
+            approx_set clbls = m_context.get_lbls(r2);
             if (!plbls.empty() && !clbls.empty()) {
                 for (unsigned plbl1 : plbls) {
                     if (m_context.get_cancel_flag()) {
@@ -3982,32 +3982,30 @@ namespace {
             TRACE("mam_inc_bug_detail", m_context.display(tout););
             TRACE("mam_inc_bug",
                   tout << "before:\n#" << r1->get_owner_id() << " #" << r2->get_owner_id() << "\n";
-                  tout << "r1.lbls:  " << r1->get_lbls() << "\n";
-                  tout << "r2.lbls:  " << r2->get_lbls() << "\n";
-                  tout << "r1.plbls: " << r1->get_plbls() << "\n";
-                  tout << "r2.plbls: " << r2->get_plbls() << "\n";);
+                  tout << "r1.lbls:  " << m_context.get_lbls(r1) << "\n";
+                  tout << "r2.lbls:  " << m_context.get_lbls(r2) << "\n";
+                  tout << "r1.plbls: " << m_context.get_plbls(r1) << "\n";
+                  tout << "r2.plbls: " << m_context.get_plbls(r2) << "\n";);
 
             process_pc(r1, r2);
             process_pc(r2, r1);
             process_pp(r1, r2);
 
-            approx_set   r1_plbls = r1->get_plbls();
-            approx_set & r2_plbls = r2->get_plbls();
-            approx_set   r1_lbls  = r1->get_lbls();
-            approx_set & r2_lbls  = r2->get_lbls();
+            approx_set r1_plbls = m_context.get_plbls(r1);
+            approx_set r1_lbls  = m_context.get_lbls(r1);
 
-            m_trail_stack.push(value_trail<approx_set>(r2_lbls));
-            m_trail_stack.push(value_trail<approx_set>(r2_plbls));
-            r2_lbls  |= r1_lbls;
-            r2_plbls |= r1_plbls;
+            m_trail_stack.push(m_context.mk_lbls_trail(r2));
+            m_trail_stack.push(m_context.mk_plbls_trail(r2));
+            m_context.get_lbls(r2)  |= r1_lbls;
+            m_context.get_plbls(r2) |= r1_plbls;
             TRACE("mam_inc_bug",
                   tout << "after:\n";
-                  tout << "r1.lbls:  " << r1->get_lbls() << "\n";
-                  tout << "r2.lbls:  " << r2->get_lbls() << "\n";
-                  tout << "r1.plbls: " << r1->get_plbls() << "\n";
-                  tout << "r2.plbls: " << r2->get_plbls() << "\n";);
-            SASSERT(approx_subset(r1->get_plbls(), r2->get_plbls()));
-            SASSERT(approx_subset(r1->get_lbls(), r2->get_lbls()));
+                  tout << "r1.lbls:  " << m_context.get_lbls(r1) << "\n";
+                  tout << "r2.lbls:  " << m_context.get_lbls(r2) << "\n";
+                  tout << "r1.plbls: " << m_context.get_plbls(r1) << "\n";
+                  tout << "r2.plbls: " << m_context.get_plbls(r2) << "\n";);
+            SASSERT(approx_subset(m_context.get_plbls(r1), m_context.get_plbls(r2)));
+            SASSERT(approx_subset(m_context.get_lbls(r1), m_context.get_lbls(r2)));
         }
     };
 }
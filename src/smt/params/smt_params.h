@@ -89,6 +89,7 @@ struct smt_params : public preprocessor_params,
     bool             m_eq_propagation;
     bool             m_binary_clause_opt;
     unsigned         m_relevancy_lvl;
+    bool             m_relevancy_lazy;
     bool             m_relevancy_lemma;
     unsigned         m_random_seed;
     double           m_random_var_freq;
@@ -245,6 +246,7 @@ struct smt_params : public preprocessor_params,
         m_eq_propagation(true),
         m_binary_clause_opt(true),
         m_relevancy_lvl(2),
+        m_relevancy_lazy(false),
         m_relevancy_lemma(false),
         m_random_seed(0),
         m_random_var_freq(0.01),
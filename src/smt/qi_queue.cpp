@@ -35,7 +35,8 @@ namespace smt {
         m_cost_function(m),
         m_new_gen_function(m),
         m_parser(m),
-        m_evaluator(m),
+        m_cost(m),
+        m_new_gen(m),
         m_subst(m),
         m_instances(m) {
         init_parser_vars();
@@ -62,6 +63,8 @@ namespace smt {
             warning_msg("invalid new_gen function '%s', switching to default one", m_params.m_qi_new_gen.c_str());
             VERIFY(m_parser.parse_string("cost", m_new_gen_function));
         }
+        m_cost.set(m_cost_function);
+        m_new_gen.set(m_new_gen_function);
         m_eager_cost_threshold = m_params.m_qi_eager_threshold;
     }
 
@@ -121,15 +124,15 @@ namespace smt {
 
     float qi_queue::get_cost(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation) {
         q::quantifier_stat * stat = set_values(q, pat, generation, min_top_generation, max_top_generation, 0);
-        float r = m_evaluator(m_cost_function, m_vals.size(), m_vals.data());
-        stat->update_max_cost(r);
+        float r = m_cost(m_vals.size(), m_vals.data());
+        stat->update_cost(r);
         return r;
     }
 
     unsigned qi_queue::get_new_gen(quantifier * q, unsigned generation, float cost) {
         // max_top_generation and min_top_generation are not available for computing inc_gen
         set_values(q, nullptr, generation, 0, 0, cost);
-        float r = m_evaluator(m_new_gen_function, m_vals.size(), m_vals.data());
+        float r = m_new_gen(m_vals.size(), m_vals.data());
         return std::max(generation + 1, static_cast<unsigned>(r));
     }
 
@@ -87,7 +87,7 @@ namespace smt {
                 return r;
             }
             else if (d->is_commutative()) {
-                r = TAG(void*, alloc(comm_table, cg_comm_hash(), cg_comm_eq(m_commutativity)), BINARY_COMM);
+                r = TAG(void*, alloc(comm_table), BINARY_COMM);
                 SASSERT(GET_TAG(r) == BINARY_COMM);
                 return r;
             }
@@ -171,7 +171,7 @@ namespace smt {
         binary_table* tb = UNTAG(binary_table*, t);
         out << "b ";
         for (enode* n : *tb) {
-            out << n->get_owner_id() << " " << cg_binary_hash()(n) << " ";
+            out << n->get_owner_id() << " " << cg_binary_key()(n) << " ";
         }
         out << "\n";
     }
@@ -217,12 +217,12 @@ namespace smt {
             return enode_bool_pair(n_prime, false);
         case BINARY:
             n_prime = UNTAG(binary_table*, t)->insert_if_not_there(n);
-            TRACE("cg_table", tout << "insert: " << n->get_owner_id() << " " << cg_binary_hash()(n) << " inserted: " << (n == n_prime) << " " << n_prime->get_owner_id() << "\n";
+            TRACE("cg_table", tout << "insert: " << n->get_owner_id() << " " << cg_binary_key()(n) << " inserted: " << (n == n_prime) << " " << n_prime->get_owner_id() << "\n";
                   display_binary(tout, t); tout << "contains_ptr: " << contains_ptr(n) << "\n";); 
             return enode_bool_pair(n_prime, false);
         case BINARY_COMM:
-            m_commutativity = false;
             n_prime = UNTAG(comm_table*, t)->insert_if_not_there(n);
+            m_commutativity = n_prime->get_arg(0)->get_root() != n->get_arg(0)->get_root();
             return enode_bool_pair(n_prime, m_commutativity);
         default:
             n_prime = UNTAG(table*, t)->insert_if_not_there(n);
@@ -230,23 +230,42 @@ namespace smt {
         }
     }
 
-    void cg_table::erase(enode * n) {
+    uint64_t cg_table::erase(enode * n) {
         SASSERT(n->get_num_args() > 0);
         void * t = get_table(n); 
         switch (static_cast<table_kind>(GET_TAG(t))) {
         case UNARY:
-            UNTAG(unary_table*, t)->erase(n);
-            break;
+            return UNTAG(unary_table*, t)->erase(n);
         case BINARY:
-            TRACE("cg_table", tout << "erase: " << n->get_owner_id() << " " << cg_binary_hash()(n) << " contains: " << contains_ptr(n) << "\n";);
-            UNTAG(binary_table*, t)->erase(n);
-            break;
+            TRACE("cg_table", tout << "erase: " << n->get_owner_id() << " " << cg_binary_key()(n) << " contains: " << contains_ptr(n) << "\n";);
+            return UNTAG(binary_table*, t)->erase(n);
         case BINARY_COMM:
-            UNTAG(comm_table*, t)->erase(n);
-            break;
+            return UNTAG(comm_table*, t)->erase(n);
         default:
             UNTAG(table*, t)->erase(n);
-            break;
+            return 0;
+        }
+    }
+
+    enode_bool_pair cg_table::reinsert(enode * n, uint64_t key, enode * old_root, enode * new_root) {
+        SASSERT(n->get_num_args() > 0);
+        enode * n_prime;
+        uint64_t old_id = old_root->get_owner_id();
+        uint64_t new_id = new_root->get_owner_id();
+        void * t = get_table(n); 
+        switch (static_cast<table_kind>(GET_TAG(t))) {
+        case UNARY:
+            n_prime = UNTAG(unary_table*, t)->insert_if_not_there(n, cg_unary_key::replace(key, old_id, new_id));
+            return enode_bool_pair(n_prime, false);
+        case BINARY:
+            n_prime = UNTAG(binary_table*, t)->insert_if_not_there(n, cg_binary_key::replace(key, old_id, new_id));
+            return enode_bool_pair(n_prime, false);
+        case BINARY_COMM:
+            n_prime = UNTAG(comm_table*, t)->insert_if_not_there(n, cg_comm_key::replace(key, old_id, new_id));
+            m_commutativity = n_prime->get_arg(0)->get_root() != n->get_arg(0)->get_root();
+            return enode_bool_pair(n_prime, m_commutativity);
+        default:
+            return insert(n);
         }
     }
 
@@ -116,8 +116,6 @@ namespace smt {
     }
 
     void context::copy(context& src_ctx, context& dst_ctx, bool override_base) {
-        ast_manager& dst_m = dst_ctx.get_manager();
-        ast_manager& src_m = src_ctx.get_manager();
         src_ctx.pop_to_base_lvl();
 
         if (!override_base && src_ctx.m_base_lvl > 0) {
@@ -125,45 +123,79 @@ namespace smt {
         }
         SASSERT(src_ctx.m_base_lvl == 0 || override_base);
 
-        ast_translation tr(src_m, dst_m, false);
+        expr_ref_vector units(src_ctx.m);
+        src_ctx.get_units_to_copy(units);
+        copy_setup(src_ctx, dst_ctx);
+        copy(src_ctx, dst_ctx, units);
+    }
 
+    void context::get_units_to_copy(expr_ref_vector& units) {
+        if (!m_setup.already_configured() || m.proofs_enabled())
+            return;
+        for (literal lit : m_assigned_literals) {
+            bool_var_data const & d = get_bdata(lit.var());
+            if (d.is_theory_atom() && !m_theories.get_plugin(d.get_theory())->is_safe_to_copy(lit.var())) {
+                continue;
+            }
+            expr_ref fml(m);
+            literal2expr(lit, fml);
+            units.push_back(fml);
+        }
+    }
+
+    void context::copy_setup(context& src_ctx, context& dst_ctx) {
         dst_ctx.set_logic(src_ctx.m_setup.get_logic());
         dst_ctx.copy_plugins(src_ctx, dst_ctx);
+        // translating macro dependencies linearizes them in the source manager.
+        src_ctx.m_asserted_formulas.get_macro_manager().copy_to(dst_ctx.m_asserted_formulas.get_macro_manager());
+    }
+
+    void context::copy(context& src_ctx, context& dst_ctx, expr_ref_vector const& units) {
+        ast_manager& dst_m = dst_ctx.get_manager();
+        ast_manager& src_m = src_ctx.get_manager();
+
+        // the source terms are kept alive by src, so the translation does not touch their reference counts.
+        ast_translation tr(src_m, dst_m, false, false);
 
         asserted_formulas& src_af = src_ctx.m_asserted_formulas;
         asserted_formulas& dst_af = dst_ctx.m_asserted_formulas;
 
         // Copy asserted formulas.
-        for (unsigned i = 0; i < src_af.get_num_formulas(); ++i) {
-            expr_ref fml(dst_m);
-            proof_ref pr(dst_m);
-            proof* pr_src = src_af.get_formula_proof(i);
-            fml = tr(src_af.get_formula(i));
-            if (pr_src) {
-                pr = tr(pr_src);
+        // Within the same manager the formulas are shared and the
+        // preprocessing that was already done for src is reused.
+        bool reuse_reduced = &src_m == &dst_m && dst_af.empty() && src_ctx.m_setup.already_configured();
+        unsigned num_reduced = 0;
+        if (reuse_reduced) {
+            dst_af.copy_reduced(src_af);
+            num_reduced = dst_af.get_qhead();
+        }
+        else {
+            for (unsigned i = 0; i < src_af.get_num_formulas(); ++i) {
+                expr_ref fml(dst_m);
+                proof_ref pr(dst_m);
+                proof* pr_src = src_af.get_formula_proof(i);
+                fml = tr(src_af.get_formula(i));
+                if (pr_src) {
+                    pr = tr(pr_src);
+                }
+                dst_af.assert_expr(fml, pr);
             }
-            dst_af.assert_expr(fml, pr);
         }
 
-        src_af.get_macro_manager().copy_to(dst_af.get_macro_manager());
-
         if (!src_ctx.m_setup.already_configured()) {
             return;
         }
 
-        for (unsigned i = 0; !src_m.proofs_enabled() && i < src_ctx.m_assigned_literals.size(); ++i) {
-            literal lit = src_ctx.m_assigned_literals[i];
-            bool_var_data const & d = src_ctx.get_bdata(lit.var());
-            if (d.is_theory_atom() && !src_ctx.m_theories.get_plugin(d.get_theory())->is_safe_to_copy(lit.var())) {
-                continue;
-            }
-            expr_ref fml0(src_m), fml1(dst_m);
-            src_ctx.literal2expr(lit, fml0);
-            fml1 = tr(fml0.get());
-            dst_ctx.assert_expr(fml1);
+        for (expr* u : units) {
+            expr_ref fml(tr(u), dst_m);
+            dst_ctx.assert_expr(fml);
         }
 
         dst_ctx.setup_context(dst_ctx.m_fparams.m_auto_config);
+        // the reduced formulas are committed in dst_af, so internalize_assertions skips them.
+        if (!dst_af.inconsistent())
+            for (unsigned i = 0; i < num_reduced; ++i)
+                dst_ctx.internalize_assertion(dst_af.get_formula(i), dst_af.get_formula_proof(i), 0);
         dst_ctx.internalize_assertions();
         
         dst_ctx.copy_user_propagator(src_ctx);
@@ -279,6 +311,11 @@ namespace smt {
         if (d.is_atom() && (relevancy_lvl() == 0 || (relevancy_lvl() == 1 && !d.is_quantifier()) || is_relevant_core(l))) {
             m_atom_propagation_queue.push_back(l);
         }
+        else if (m_fparams.m_relevancy_lazy && (d.is_enode() || d.is_eq() || d.is_theory_atom() || d.is_quantifier())) {
+            // the atom is only propagated to the egraph, theories or quantifier
+            // instantiation once it is relevant.
+            m_relevancy_demanded = true;
+        }
 
         if (m.has_trace_stream())
             trace_assign(l, j, decision);
@@ -563,8 +600,11 @@ namespace smt {
     /**
        \brief When merging to equivalence classes, the parents of the smallest one (that are congruence roots),
        must be removed from the congruence table since their hash code will change.
+       The keys of the removed parents are saved in m_cg_keys, in the order of the
+       parents, so that reinsert_parents_into_cg_table can update them.
     */
     void context::remove_parents_from_cg_table(enode * r1) {
+        m_cg_keys.reset();
         // Remove parents from the congruence table
         for (enode * parent : enode::parents(r1)) {
             CTRACE("add_eq", !parent->is_marked() && parent->is_cgc_enabled() && parent->is_true_eq() && m_cg_table.contains_ptr(parent), tout << parent->get_owner_id() << "\n";);
@@ -584,10 +624,12 @@ namespace smt {
             if (!parent->is_marked() && parent->is_cgr() && !parent->is_true_eq()) {
                 SASSERT(!parent->is_cgc_enabled() || m_cg_table.contains_ptr(parent));
                 parent->set_mark();
+                uint64_t key = 0;
                 if (parent->is_cgc_enabled()) {
-                    m_cg_table.erase(parent);
+                    key = m_cg_table.erase(parent);
                     SASSERT(!m_cg_table.contains_ptr(parent));
                 }
+                m_cg_keys.push_back(key);
             }
         }
     }
@@ -609,11 +651,13 @@ namespace smt {
         enode_vector & r2_parents  = r2->m_parents;
         enode_vector & r1_parents  = r1->m_parents;
         unsigned num_r1_parents = r1_parents.size();
+        unsigned num_keys = 0;
         for (unsigned i = 0; i < num_r1_parents; ++i) {
             enode* parent = r1_parents[i];
             if (!parent->is_marked())
                 continue;
             parent->unset_mark();
+            uint64_t key = m_cg_keys[num_keys++];
             if (parent->is_eq()) {
                 SASSERT(parent->get_num_args() == 2);
                 TRACE("add_eq_bug", tout << "visiting: #" << parent->get_owner_id() << "\n";);
@@ -635,7 +679,7 @@ namespace smt {
                 }
             }
             if (parent->is_cgc_enabled()) {
-                enode_bool_pair pair = m_cg_table.insert(parent);
+                enode_bool_pair pair = m_cg_table.reinsert(parent, key, r1, r2);
                 enode * parent_prime = pair.first;
                 if (parent_prime == parent) {
                     SASSERT(parent);
@@ -659,6 +703,7 @@ namespace smt {
                 r2_parents.push_back(parent);
             }
         }
+        SASSERT(num_keys == m_cg_keys.size());
     }
 
     /**
@@ -1590,11 +1635,26 @@ namespace smt {
     /**
        \brief Propagate relevancy using the queue of new assigned literals
        located at [qhead, m_assigned_literals.size()).
+
+       In lazy relevancy mode, assignments are only passed to the relevancy
+       propagator when their relevancy is demanded: when an atom that waits
+       for relevancy is assigned, when a theory or quantifier instantiation
+       queries is_relevant, and before final check. The queue then starts at
+       m_relevancy_qhead. Assignments that are undone before they are demanded
+       are never processed.
     */
     void context::propagate_relevancy(unsigned qhead) {
-        if (!relevancy())
-            return;
+        m_relevancy_demanded = false;
         unsigned sz = m_assigned_literals.size();
+        if (!relevancy()) {
+            m_relevancy_qhead = sz;
+            return;
+        }
+        if (m_fparams.m_relevancy_lazy) {
+            qhead = m_relevancy_qhead;
+            m_stats.m_num_relevancy_flushes++;
+        }
+        m_relevancy_qhead = sz;
         while (qhead < sz) {
             literal l      = m_assigned_literals[qhead];
             SASSERT(get_assignment(l) == l_true);
@@ -1658,6 +1718,7 @@ namespace smt {
     bool context::can_propagate() const {
         return
             m_qhead != m_assigned_literals.size() ||
+            (m_relevancy_demanded && m_relevancy_qhead != m_assigned_literals.size()) ||
             m_relevancy_propagator->can_propagate() ||
             !m_atom_propagation_queue.empty() ||
             m_qmanager->can_propagate() ||
@@ -1695,7 +1756,8 @@ namespace smt {
                 if (!propagate_th_case_split(qhead))
                     return false;
                 SASSERT(!inconsistent());
-                propagate_relevancy(qhead);
+                if (!m_fparams.m_relevancy_lazy || m_relevancy_demanded)
+                    propagate_relevancy(qhead);
                 if (inconsistent())
                     return false;
                 if (!propagate_atoms())
@@ -1925,6 +1987,7 @@ namespace smt {
         s.m_aux_clauses_lim          = m_aux_clauses.size();
         s.m_justifications_lim       = m_justifications.size();
         s.m_units_to_reassert_lim    = m_units_to_reassert.size();
+        s.m_relevancy_qhead_lim      = m_relevancy_qhead;
 
         m_qmanager->push();
 
@@ -2073,6 +2136,9 @@ namespace smt {
             m_case_split_queue->unassign_var_eh(v);
         }
 
+        if (m_fparams.m_relevancy_lazy && m_relevancy_qhead < m_assigned_literals.size())
+            m_stats.m_num_relevancy_skipped += m_assigned_literals.size() - std::max(m_relevancy_qhead, old_lim);
+        m_relevancy_qhead = std::min(m_relevancy_qhead, old_lim);
         m_assigned_literals.shrink(old_lim);
         m_qhead = old_lim;
         SASSERT(m_qhead == m_assigned_literals.size());
@@ -2426,6 +2492,9 @@ namespace smt {
 
             m_fingerprints.pop_scope(num_scopes);
             unassign_vars(s.m_assigned_literals_lim);
+            // relevancy propagated in the popped scopes is undone, also for
+            // assignments that were made before the scopes were pushed.
+            m_relevancy_qhead = std::min(m_relevancy_qhead, s.m_relevancy_qhead_lim);
             undo_trail_stack(s.m_trail_stack_lim);
 
             for (theory* th : m_theory_set) 
@@ -3842,6 +3911,11 @@ namespace smt {
             if (!decide()) {
                 if (inconsistent()) 
                     return l_false;
+                if (m_fparams.m_relevancy_lazy && m_relevancy_qhead != m_assigned_literals.size()) {
+                    // final check requires the relevancy of all assignments.
+                    m_relevancy_demanded = true;
+                    continue;
+                }
                 final_check_status fcs = final_check();
                 TRACE("final_check_result", tout << "fcs: " << fcs << " last_search_failure: " << m_last_search_failure << "\n";);
                 switch (fcs) {
@@ -123,11 +123,14 @@ namespace smt {
         enode *                     m_false_enode;
         app2enode_t                 m_app2enode;    // app -> enode
         ptr_vector<enode>           m_enodes;
+        svector<approx_set>         m_lbls;         // owner id -> E-matching labels, see get_lbls
+        svector<approx_set>         m_plbls;        // owner id -> E-matching parent labels
         plugin_manager<theory>      m_theories;     // mapping from theory_id -> theory
         ptr_vector<theory>          m_theory_set;   // set of theories for fast traversal
         vector<enode_vector>        m_decl2enodes;  // decl -> enode (for decls with arity > 0)
         enode_vector                m_empty_vector;
         cg_table                    m_cg_table;
+        svector<uint64_t>           m_cg_keys;      // keys of the parents removed from m_cg_table during add_eq
         struct new_eq {
             enode *                 m_lhs;
             enode *                 m_rhs;
@@ -181,6 +184,8 @@ namespace smt {
         typedef std::pair<clause*, literal_vector> tmp_clause;
         vector<tmp_clause>          m_tmp_clauses;
         unsigned                    m_qhead { 0 };
+        unsigned                    m_relevancy_qhead { 0 }; //!< assigned literals before this index were passed to the relevancy propagator
+        mutable bool                m_relevancy_demanded { false }; //!< relevancy of pending assignments was queried in lazy mode
         unsigned                    m_simp_qhead { 0 };
         int                         m_simp_counter { 0 }; //!< can become negative
         scoped_ptr<case_split_queue> m_case_split_queue;
@@ -281,6 +286,35 @@ namespace smt {
             return m_app2enode[n->get_id()];
         }
 
+        /**
+           \brief Label sets used by E-matching (mam) to filter candidate
+           matches. They are indexed by owner id and only grow when a mam
+           assigns labels, so ground problems do not pay for them.
+        */
+        approx_set & get_lbls(enode * n) {
+            unsigned id = n->get_owner_id();
+            if (id >= m_lbls.size())
+                m_lbls.resize(id + 1);
+            return m_lbls[id];
+        }
+
+        approx_set & get_plbls(enode * n) {
+            unsigned id = n->get_owner_id();
+            if (id >= m_plbls.size())
+                m_plbls.resize(id + 1);
+            return m_plbls[id];
+        }
+
+        vector_value_trail<approx_set, false> mk_lbls_trail(enode * n) {
+            get_lbls(n);
+            return vector_value_trail<approx_set, false>(m_lbls, n->get_owner_id());
+        }
+
+        vector_value_trail<approx_set, false> mk_plbls_trail(enode * n) {
+            get_plbls(n);
+            return vector_value_trail<approx_set, false>(m_plbls, n->get_owner_id());
+        }
+
         /**
            \brief Similar to get_enode, but returns 0 if n is to e_internalized.
         */
@@ -628,6 +662,7 @@ namespace smt {
             unsigned                m_aux_clauses_lim;
             unsigned                m_justifications_lim;
             unsigned                m_units_to_reassert_lim;
+            unsigned                m_relevancy_qhead_lim;
         };
         struct base_scope {
             unsigned                m_lemmas_lim;
@@ -1264,8 +1299,16 @@ namespace smt {
         // event handler for relevancy_propagator class
         void relevant_eh(expr * n);
 
+        /**
+           \brief In lazy relevancy mode, a query while assignments are pending
+           requests relevancy propagation at the next step of propagate().
+        */
         bool is_relevant(expr * n) const {
-            return !relevancy() || is_relevant_core(n);
+            if (!relevancy())
+                return true;
+            if (m_relevancy_qhead != m_assigned_literals.size())
+                m_relevancy_demanded = true;
+            return is_relevant_core(n);
         }
 
         bool is_relevant(enode * n) const {
@@ -1595,6 +1638,25 @@ namespace smt {
 
         static void copy(context& src, context& dst, bool override_base = false);
 
+        /**
+           \brief Collect the base-level literals that are transferred by copy.
+           The expressions are created in the manager of this context.
+         */
+        void get_units_to_copy(expr_ref_vector& units);
+
+        /**
+           \brief Copy the logic, theory plugins and macros of src into dst.
+           This can update the manager of src, so it must not run concurrently with other copies of src.
+         */
+        static void copy_setup(context& src, context& dst);
+
+        /**
+           \brief Copy the assertions of src into dst, where src is at base level, units were obtained
+           by get_units_to_copy and copy_setup was already applied.
+           src and its manager are only read, so several copies of src can be created concurrently.
+         */
+        static void copy(context& src, context& dst, expr_ref_vector const& units);
+
         /**
            \brief Translate context to use new manager m.
          */
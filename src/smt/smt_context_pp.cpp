@@ -402,6 +402,8 @@ namespace smt {
         st.update("max generation", m_stats.m_max_generation);
         st.update("minimized lits", m_stats.m_num_minimized_lits);
         st.update("num checks", m_stats.m_num_checks);
+        st.update("relevancy flushes", m_stats.m_num_relevancy_flushes);
+        st.update("relevancy skipped lits", m_stats.m_num_relevancy_skipped);
         st.update("mk bool var", m_stats.m_num_mk_bool_var ? m_stats.m_num_mk_bool_var - 1 : 0);
         m_qmanager->collect_statistics(st);
         m_asserted_formulas.collect_statistics(st);
@@ -544,8 +546,17 @@ namespace smt {
     }
 
     void context::display_enodes_lbls(std::ostream & out) const {
+        auto lbls = [&](svector<approx_set> const & v, enode * n) {
+            unsigned id = n->get_owner_id();
+            return id < v.size() ? v[id] : approx_set();
+        };
         for (enode* n : m_enodes) {
-            n->display_lbls(out);
+            enode * r = n->get_root();
+            out << "#" << n->get_owner_id() << "  ->  #" << r->get_owner_id() << ", lbls: " << lbls(m_lbls, n) << ", plbls: " << lbls(m_plbls, n)
+                << ", root->lbls: " << lbls(m_lbls, r) << ", root->plbls: " << lbls(m_plbls, r);
+            if (n->has_lbl_hash())
+                out << ", lbl-hash: " << static_cast<int>(n->get_lbl_hash());
+            out << "\n";
         }
     }
 
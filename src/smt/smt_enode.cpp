@@ -150,11 +150,10 @@ namespace smt {
         ctx.push_trail(value_trail<signed char>(m_lbl_hash));
         unsigned h = hash_u(get_owner_id());
         m_lbl_hash = h & (APPROX_SET_CAPACITY - 1);
-        // propagate modification to the root m_lbls set.
-        approx_set & r_lbls = m_root->m_lbls;
-        if (!r_lbls.may_contain(m_lbl_hash)) {
-            ctx.push_trail(value_trail<approx_set>(r_lbls));
-            r_lbls.insert(m_lbl_hash);
+        // propagate modification to the label set of the root.
+        if (!ctx.get_lbls(m_root).may_contain(m_lbl_hash)) {
+            ctx.push_trail(ctx.mk_lbls_trail(m_root));
+            ctx.get_lbls(m_root).insert(m_lbl_hash);
         }
     }
 
@@ -267,13 +266,6 @@ namespace smt {
 
 #endif
 
-    void enode::display_lbls(std::ostream & out) const {
-        out << "#" << get_owner_id() << "  ->  #" << get_root()->get_owner_id() << ", lbls: " << get_lbls() << ", plbls: " << get_plbls() 
-            << ", root->lbls: " << get_root()->get_lbls() << ", root->plbls: " << get_root()->get_plbls();
-        if (has_lbl_hash())
-            out << ", lbl-hash: " << static_cast<int>(get_lbl_hash());
-        out << "\n";
-    }
 
     bool congruent(enode * n1, enode * n2, bool & comm) {
         comm          = false;
@@ -59,13 +59,13 @@ namespace smt {
        equality propagation, and the theory central bus of equalities.
     */
     class enode {
+        // Fields used by congruence closure and merge loops come first,
+        // fields used by E-matching and proof logging come last.
         app  *              m_owner;    //!< The application that 'owns' this enode.
         enode *             m_root;     //!< Representative of the equivalence class
         enode *             m_next;     //!< Next element in the equivalence class.
         enode *             m_cg;       
         unsigned            m_class_size;    //!< Size of the equivalence class if the enode is the root.
-        unsigned            m_generation; //!< Tracks how many quantifier instantiation rounds were needed to generate this enode.
-
         unsigned            m_func_decl_id; //!< Id generated by the congruence table for fast indexing.
 
         unsigned            m_mark:1;        //!< Multi-purpose auxiliary mark. 
@@ -77,6 +77,9 @@ namespace smt {
         unsigned            m_bool:1;           //!< True if it is a boolean enode
         unsigned            m_merge_tf:1;       //!< True if the enode should be merged with true/false when the associated boolean variable is assigned.
         unsigned            m_cgc_enabled:1;    //!< True if congruence closure is enabled for this enode.
+        unsigned            m_proof_is_logged:1;  //!< Indicates that the proof for the enode being equal to its root is in the log.
+        signed char         m_lbl_hash;         //!< It is different from -1, if enode is used in a pattern
+        unsigned            m_generation; //!< Tracks how many quantifier instantiation rounds were needed to generate this enode.
         unsigned            m_iscope_lvl;       //!< When the enode was internalized
         /*
           The following property is valid for m_parents
@@ -96,10 +99,8 @@ namespace smt {
         enode_vector        m_parents;          //!< Parent enodes of the equivalence class.
         id_var_list<>       m_th_var_list;      //!< List of theories that 'care' about this enode.
         trans_justification m_trans;            //!< A justification for the enode being equal to its root.
-        bool                m_proof_is_logged;  //!< Indicates that the proof for the enode being equal to its root is in the log.
-        signed char         m_lbl_hash;         //!< It is different from -1, if enode is used in a pattern
-        approx_set          m_lbls;
-        approx_set          m_plbls;
+        // The label sets used by E-matching are kept in context::get_lbls and
+        // context::get_plbls, so that ground problems do not pay for them.
         enode *             m_args[0];          //!< Cached args
         
         friend class context;
@@ -395,24 +396,6 @@ namespace smt {
             return static_cast<unsigned char>(m_lbl_hash);
         }
         
-        approx_set & get_lbls() {
-            return m_lbls;
-        }
-        
-        approx_set & get_plbls() {
-            return m_plbls;
-        }
-        
-        const approx_set & get_lbls() const {
-            return m_lbls;
-        }
-        
-        const approx_set & get_plbls() const {
-            return m_plbls;
-        }
-
-        void display_lbls(std::ostream & out) const;
-        
 #ifdef Z3DEBUG
         bool check_invariant() const;
         bool trans_reaches(enode * n) const;
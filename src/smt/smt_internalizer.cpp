@@ -979,6 +979,10 @@ namespace smt {
         TRACE("mk_var_bug", tout << "mk_enode: " << id << "\n";);
         TRACE("generation", tout << "mk_enode: " << id << " " << generation << "\n";);
         m_app2enode.setx(id, e, nullptr);
+        if (id < m_lbls.size())
+            m_lbls[id].reset();
+        if (id < m_plbls.size())
+            m_plbls[id].reset();
         m_e_internalized_stack.push_back(n);
         m_trail_stack.push_back(&m_mk_enode_trail);
         m_enodes.push_back(e);
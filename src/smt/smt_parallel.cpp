@@ -36,6 +36,7 @@ namespace smt {
 #else
 
 #include <thread>
+#include <condition_variable>
 
 namespace smt {
     
@@ -46,6 +47,7 @@ namespace smt {
         flet<unsigned> _nt(ctx.m_fparams.m_threads, 1);
         unsigned thread_max_conflicts = ctx.get_fparams().m_threads_max_conflicts;
         unsigned max_conflicts = ctx.get_fparams().m_max_conflicts;
+        unsigned cube_frequency = std::max(1u, ctx.get_fparams().m_threads_cube_frequency);
 
         // try first sequential with a low conflict budget to make super easy problems cheap
         unsigned max_c = std::min(thread_max_conflicts, 40u);
@@ -71,8 +73,7 @@ namespace smt {
         std::string        ex_msg;
         par_exception_kind ex_kind = DEFAULT_EX;
         unsigned error_code = 0;
-        bool done = false;
-        unsigned num_rounds = 0;
+        std::mutex setup_mux;
         if (m.has_trace_stream())
             throw default_exception("trace streams have to be off in parallel mode");
 
@@ -80,147 +81,262 @@ namespace smt {
         for (unsigned i = 0; i < num_threads; ++i) {
             smt_params.push_back(ctx.get_fparams());
         }
+
+        // Workers are copied from m concurrently. Everything that creates terms in m
+        // or otherwise updates it (plugin inheritance, macros and their dependencies)
+        // is done up front, so that the copies only read m.
+        ctx.pop_to_base_lvl();
+        expr_ref_vector units(m);
+        ctx.get_units_to_copy(units);
         for (unsigned i = 0; i < num_threads; ++i) {
             ast_manager* new_m = alloc(ast_manager, m, true);
             pms.push_back(new_m);
-            pctxs.push_back(alloc(context, *new_m, smt_params[i], ctx.get_params())); 
-            context& new_ctx = *pctxs.back();
-            context::copy(ctx, new_ctx, true);
-            new_ctx.set_random_seed(i + ctx.get_fparams().m_random_seed);
-            ast_translation tr(m, *new_m);
+            pctxs.push_back(alloc(context, *new_m, smt_params[i], ctx.get_params()));
+            context::copy_setup(ctx, *pctxs[i]);
+        }
+        {
+            auto setup_worker = [&](unsigned i) {
+                try {
+                    context::copy(ctx, *pctxs[i], units);
+                    pctxs[i]->set_random_seed(i + ctx.get_fparams().m_random_seed);
+                }
+                catch (z3_exception & ex) {
+                    std::lock_guard<std::mutex> lock(setup_mux);
+                    ex_msg = ex.msg();
+                }
+            };
+            vector<std::thread> threads(num_threads);
+            for (unsigned i = 0; i < num_threads; ++i) 
+                threads[i] = std::thread([&, i]() { setup_worker(i); });
+            for (auto & th : threads) 
+                th.join();
+        }
+        if (!ex_msg.empty())
+            throw default_exception(std::move(ex_msg));
+        for (unsigned i = 0; i < num_threads; ++i) {
+            ast_translation tr(m, *pms[i]);
             pasms.push_back(tr(asms));
-            sl.push_child(&(new_m->limit()));
         }
+        for (ast_manager* pm : pms) 
+            sl.push_child(&(pm->limit()));
 
-        auto cube = [](context& ctx, expr_ref_vector& lasms, expr_ref& c) {
-            lookahead lh(ctx);
-            c = lh.choose();
-            if (c) {
-                if ((ctx.get_random_value() % 2) == 0) 
-                    c = c.get_manager().mk_not(c);
-                lasms.push_back(c);
-            }
-        };
+        // The state below lives in the manager m of the main context and is protected by mux.
+        // Cubes form a partition of the search space: the open cubes are those in the pool 
+        // together with the cubes currently owned by workers. The problem is unsatisfiable 
+        // when the last open cube is refuted.
+        std::mutex mux;
+        std::condition_variable cv;
+        vector<expr_ref_vector> cube_pool;
+        unsigned num_open_cubes = 1;
+        unsigned num_idle = 0;
+        unsigned num_conflicts = 0;
+        bool done = false;
+        obj_hashtable<expr> core_set;
+        expr_ref_vector core(m);
+        cube_pool.push_back(expr_ref_vector(m));
 
         obj_hashtable<expr> unit_set;
-        expr_ref_vector unit_trail(ctx.m);
-        unsigned_vector unit_lim;
-        for (unsigned i = 0; i < num_threads; ++i) unit_lim.push_back(0);
+        expr_ref_vector unit_trail(m);
+        unsigned_vector unit_lim_in(num_threads, 0u), unit_lim_out(num_threads, 0u);
+        unsigned num_splits = 0;
 
-        std::function<void(void)> collect_units = [&,this]() {
-            for (unsigned i = 0; i < num_threads; ++i) {
-                context& pctx = *pctxs[i];
-                pctx.pop_to_base_lvl();
-                ast_translation tr(pctx.m, ctx.m);
-                unsigned sz = pctx.assigned_literals().size();
-                for (unsigned j = unit_lim[i]; j < sz; ++j) {
-                    literal lit = pctx.assigned_literals()[j];
-                    expr_ref e(pctx.bool_var2expr(lit.var()), pctx.m);
-                    if (lit.sign()) e = pctx.m.mk_not(e);
-                    expr_ref ce(tr(e.get()), ctx.m);
-                    if (!unit_set.contains(ce)) {
-                        unit_set.insert(ce);
-                        unit_trail.push_back(ce);
-                    }
-                }
+        auto cancel_workers = [&]() {
+            for (ast_manager* pm : pms) 
+                pm->limit().cancel();
+        };
+
+        // caller holds mux.
+        auto finish = [&](unsigned i, lbool r) {
+            if (finished_id == UINT_MAX || (r != l_undef && result == l_undef)) {
+                finished_id = i;
+                result = r;
             }
+            done = true;
+            cv.notify_all();
+            cancel_workers();
+        };
 
-            unsigned sz = unit_trail.size();
-            for (unsigned i = 0; i < num_threads; ++i) {
-                context& pctx = *pctxs[i];
-                ast_translation tr(ctx.m, pctx.m);
-                for (unsigned j = unit_lim[i]; j < sz; ++j) {
-                    expr_ref src(ctx.m), dst(pctx.m);
-                    dst = tr(unit_trail.get(j));
-                    pctx.assert_expr(dst);
+        // block until a cube is available or the search is over.
+        auto get_cube = [&](unsigned i, expr_ref_vector& cube) {
+            std::unique_lock<std::mutex> lock(mux);
+            ++num_idle;
+            cv.wait(lock, [&]() { return done || !cube_pool.empty(); });
+            --num_idle;
+            if (done) 
+                return false;
+            ast_translation tr(m, *pms[i]);
+            cube.reset();
+            for (expr* e : cube_pool.back())
+                cube.push_back(tr(e));
+            cube_pool.pop_back();
+            return true;
+        };
+
+        // publish new units of worker i and import units found by other workers.
+        auto share_units = [&](unsigned i) {
+            context& pctx = *pctxs[i];
+            pctx.pop_to_base_lvl();
+            std::lock_guard<std::mutex> lock(mux);
+            ast_translation tr(pctx.m, m);
+            unsigned sz = pctx.assigned_literals().size();
+            for (unsigned j = unit_lim_out[i]; j < sz; ++j) {
+                literal lit = pctx.assigned_literals()[j];
+                expr_ref e(pctx.bool_var2expr(lit.var()), pctx.m);
+                if (lit.sign()) e = pctx.m.mk_not(e);
+                expr_ref ce(tr(e.get()), m);
+                if (!unit_set.contains(ce)) {
+                    unit_set.insert(ce);
+                    unit_trail.push_back(ce);
                 }
-                unit_lim[i] = sz;
             }
-            IF_VERBOSE(1, verbose_stream() << "(smt.thread :units " << sz << ")\n");
+            ast_translation tr2(m, pctx.m);
+            for (unsigned j = unit_lim_in[i]; j < unit_trail.size(); ++j) 
+                pctx.assert_expr(tr2(unit_trail.get(j)));
+            unit_lim_in[i] = unit_trail.size();
+            unit_lim_out[i] = pctx.assigned_literals().size();
         };
 
-        std::mutex mux;
-
         auto worker_thread = [&](int i) {
             try {
                 context& pctx = *pctxs[i];
                 ast_manager& pm = *pms[i];
-                expr_ref_vector lasms(pasms[i]);
-                expr_ref c(pm);
-
-                pctx.get_fparams().m_max_conflicts = std::min(thread_max_conflicts, max_conflicts);
-                if (num_rounds > 0 && (pctx.get_fparams().m_threads_cube_frequency % num_rounds) == 0) {
-                    cube(pctx, lasms, c);
-                }
-                IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i; 
-                           if (num_rounds > 0) verbose_stream() << " :round " << num_rounds;
-                           if (c) verbose_stream() << " :cube " << mk_bounded_pp(c, pm, 3);
-                           verbose_stream() << ")\n";);
-                lbool r = pctx.check(lasms.size(), lasms.data());
-                
-                if (r == l_undef && pctx.m_num_conflicts >= max_conflicts) {
-                    // no-op
-                }
-                else if (r == l_undef && pctx.m_num_conflicts >= thread_max_conflicts) {
-                    return;
-                }                
-                else if (r == l_false && pctx.unsat_core().contains(c)) {
-                    IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :learn " << mk_bounded_pp(c, pm, 3) << ")");
-                    pctx.assert_expr(mk_not(mk_and(pctx.unsat_core())));
+                expr_ref_vector cube(pm), lasms(pm);
+                obj_hashtable<expr> cube_set;
+                unsigned budget = 0, num_attempts = 0;
+                auto next_cube = [&]() {
+                    if (!get_cube(i, cube))
+                        return false;
+                    cube_set.reset();
+                    for (expr* e : cube) 
+                        cube_set.insert(e);
+                    budget = thread_max_conflicts;
+                    num_attempts = 0;
+                    return true;
+                };
+                if (!next_cube())
                     return;
-                } 
-                
-
-                bool first = false;
-                {
-                    std::lock_guard<std::mutex> lock(mux);
-                    if (finished_id == UINT_MAX) {
-                        finished_id = i;
-                        first = true;
-                        result = r;
-                        done = true;
+                while (true) {
+                    lasms.reset();
+                    lasms.append(pasms[i]);
+                    lasms.append(cube);
+                    pctx.get_fparams().m_max_conflicts = budget;
+                    IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :cube-size " << cube.size() << " :budget " << budget << ")\n";);
+                    lbool r = pctx.check(lasms.size(), lasms.data());
+                    unsigned used = pctx.m_num_conflicts;
+
+                    if (r == l_true) {
+                        std::lock_guard<std::mutex> lock(mux);
+                        finish(i, r);
+                        return;
                     }
-                    if (!first && r != l_undef && result == l_undef) {
-                        finished_id = i;
-                        result = r;                        
+                    if (r == l_undef && used < budget) {
+                        // canceled or incomplete
+                        std::lock_guard<std::mutex> lock(mux);
+                        finish(i, r);
+                        return;
                     }
-                    else if (!first) return;
-                }
-
-                for (ast_manager* m : pms) {
-                    if (m != &pm) m->limit().cancel();
+                    if (r == l_false) {
+                        bool uses_cube = false;
+                        for (expr* e : pctx.unsat_core()) 
+                            uses_cube |= cube_set.contains(e);
+                        if (uses_cube) {
+                            share_units(i);
+                            IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :learn " << mk_bounded_pp(mk_not(mk_and(pctx.unsat_core())), pm, 3) << ")\n");
+                            pctx.assert_expr(mk_not(mk_and(pctx.unsat_core())));
+                        }
+                        std::unique_lock<std::mutex> lock(mux);
+                        ast_translation tr(pm, m);
+                        if (!uses_cube) {
+                            core.reset();
+                            core_set.reset();
+                        }
+                        for (expr* e : pctx.unsat_core()) {
+                            if (cube_set.contains(e))
+                                continue;
+                            expr_ref ce(tr(e), m);
+                            if (!core_set.contains(ce)) {
+                                core_set.insert(ce);
+                                core.push_back(ce);
+                            }
+                        }
+                        --num_open_cubes;
+                        if (!uses_cube || num_open_cubes == 0) {
+                            finish(i, l_false);
+                            return;
+                        }
+                        lock.unlock();
+                        if (!next_cube())
+                            return;
+                        continue;
+                    }
+                    share_units(i);
+                    bool split = false;
+                    {
+                        std::lock_guard<std::mutex> lock(mux);
+                        num_conflicts += used;
+                        if (done)
+                            return;
+                        if (num_conflicts >= max_conflicts) {
+                            finish(i, l_undef);
+                            return;
+                        }
+                        ++num_attempts;
+                        split = num_idle > 0 || (cube_pool.empty() && num_attempts % cube_frequency == 0);
+                    }
+                    if (split) {
+                        lookahead lh(pctx);
+                        expr_ref c = lh.choose();
+                        if (c) {
+                            if ((pctx.get_random_value() % 2) == 0) 
+                                c = pm.mk_not(c);
+                            std::lock_guard<std::mutex> lock(mux);
+                            ast_translation tr(pm, m);
+                            expr_ref_vector other(m);
+                            for (expr* e : cube)
+                                other.push_back(tr(e));
+                            other.push_back(mk_not(m, tr(c.get())));
+                            cube_pool.push_back(other);
+                            ++num_open_cubes;
+                            ++num_splits;
+                            cube.push_back(c);
+                            cube_set.insert(c);
+                            num_attempts = 0;
+                            cv.notify_one();
+                            IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :split " << mk_bounded_pp(c, pm, 3) << ")\n");
+                            continue;
+                        }
+                    }
+                    budget = budget > UINT_MAX / 2 ? UINT_MAX : 2 * budget;
                 }
-
             }
             catch (z3_error & err) {
+                std::lock_guard<std::mutex> lock(mux);
                 error_code = err.error_code();
                 ex_kind = ERROR_EX;                
                 done = true;
+                cv.notify_all();
+                cancel_workers();
             }
             catch (z3_exception & ex) {
+                std::lock_guard<std::mutex> lock(mux);
                 ex_msg = ex.msg();
                 ex_kind = DEFAULT_EX;    
                 done = true;
+                cv.notify_all();
+                cancel_workers();
             }
         };
 
         // for debugging:  num_threads = 1;
 
-        while (true) {
-            vector<std::thread> threads(num_threads);
-            for (unsigned i = 0; i < num_threads; ++i) {
-                threads[i] = std::thread([&, i]() { worker_thread(i); });
-            }
-            for (auto & th : threads) {
-                th.join();
-            }
-            if (done) break;
-
-            collect_units();
-            ++num_rounds;
-            max_conflicts = (max_conflicts < thread_max_conflicts) ? 0 : (max_conflicts - thread_max_conflicts);
-            thread_max_conflicts *= 2;            
+        vector<std::thread> threads(num_threads);
+        for (unsigned i = 0; i < num_threads; ++i) {
+            threads[i] = std::thread([&, i]() { worker_thread(i); });
+        }
+        for (auto & th : threads) {
+            th.join();
         }
+        IF_VERBOSE(1, verbose_stream() << "(smt.parallel :splits " << num_splits << " :units " << unit_trail.size() << ")\n");
 
         for (context* c : pctxs) {
             c->collect_statistics(ctx.m_aux_stats);
@@ -244,8 +360,7 @@ namespace smt {
             break;
         case l_false:
             ctx.m_unsat_core.reset();
-            for (expr* e : pctx.unsat_core()) 
-                ctx.m_unsat_core.push_back(tr(e));
+            ctx.m_unsat_core.append(core);
             break;
         default:
             break;
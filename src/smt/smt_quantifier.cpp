@@ -167,6 +167,7 @@ namespace smt {
 
         bool has_quantifiers() const { return !m_quantifiers.empty(); }
 
+        // [quantifier_instances] qid : instances : simplify true : checker sat : max generation : max cost : avg cost
         void display_stats(std::ostream & out, quantifier * q) {
             q::quantifier_stat * s     = get_stat(q);
             unsigned num_instances  = s->get_num_instances();
@@ -174,6 +175,7 @@ namespace smt {
             unsigned num_instances_checker_sat  = s->get_num_instances_checker_sat();
             unsigned max_generation = s->get_max_generation();
             float max_cost          = s->get_max_cost();
+            float avg_cost          = s->get_avg_cost();
             if (num_instances > 0 || num_instances_simplify_true>0 || num_instances_checker_sat>0) {
                 out << "[quantifier_instances] ";
                 out.width(10);
@@ -185,7 +187,7 @@ namespace smt {
                 out.width(3);
                 out << num_instances_checker_sat << " : ";
                 out.width(3);
-                out << max_generation << " : " << max_cost << "\n";
+                out << max_generation << " : " << max_cost << " : " << avg_cost << "\n";
             }
         }
 
@@ -47,6 +47,8 @@ namespace smt {
         unsigned m_num_checks;
         unsigned m_num_simplifications;
         unsigned m_num_del_clauses;
+        unsigned m_num_relevancy_flushes;
+        unsigned m_num_relevancy_skipped;
         statistics() {
             reset();
         }
@@ -180,6 +180,25 @@ void asserted_formulas::assert_expr(expr * e) {
     assert_expr(e, m.proofs_enabled() ? m.mk_asserted(e) : nullptr);
 }
 
+/**
+   \brief Copy the formulas of \c src, which uses the same ast_manager, into
+   this (empty) set. Formulas that \c src already preprocessed are not
+   preprocessed again.
+*/
+void asserted_formulas::copy_reduced(asserted_formulas const& src) {
+    SASSERT(&m == &src.m);
+    SASSERT(empty());
+    force_push();
+    unsigned qhead = src.m_qhead;
+    for (unsigned i = 0; i < qhead; ++i)
+        m_formulas.push_back(src.m_formulas[i]);
+    m_has_quantifiers = src.m_has_quantifiers;
+    m_inconsistent = src.m_inconsistent;
+    commit(qhead);
+    for (unsigned i = qhead; i < src.m_formulas.size(); ++i)
+        assert_expr(src.get_formula(i), src.get_formula_proof(i));
+}
+
 void asserted_formulas::get_assertions(ptr_vector<expr> & result) const {
     for (justified_expr const& je : m_formulas) result.push_back(je.get_fml());
 }
@@ -245,6 +245,7 @@ public:
     void setup();
     void assert_expr(expr * e, proof * in_pr);
     void assert_expr(expr * e);
+    void copy_reduced(asserted_formulas const& src);
     void reset();
     void push_scope();
     void pop_scope(unsigned num_scopes);
@@ -0,0 +1,107 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    ast_binary.cpp
+
+Abstract:
+
+    Test the binary AST format.
+
+--*/
+#include<cstdio>
+#include<string>
+#include "api/z3.h"
+#include "util/debug.h"
+
+static char const * g_benchmark =
+    "(declare-datatypes () ((IList (nil) (cons (hd Int) (tl IList)))))\n"
+    "(declare-sort U 0)\n"
+    "(declare-fun f (U Int) U)\n"
+    "(declare-fun g (Int) Int)\n"
+    "(declare-const u U)\n"
+    "(declare-const x Int)\n"
+    "(declare-const y Real)\n"
+    "(declare-const b (_ BitVec 16))\n"
+    "(declare-const a (Array Int IList))\n"
+    "(declare-const s String)\n"
+    "(declare-const r (_ FloatingPoint 8 24))\n"
+    "(assert (forall ((z Int)) (! (> (g z) (- 100000000000000000000000)) :pattern ((g z)) :qid q1)))\n"
+    "(assert (= (f (f u x) (+ x 1)) u))\n"
+    "(assert (< (/ 1 3) y 2.5))\n"
+    "(assert (= (bvadd b #x00ff) (concat ((_ extract 7 0) b) #x01)))\n"
+    "(assert (is-cons (select a x)))\n"
+    "(assert (= (hd (select a x)) (g x)))\n"
+    "(assert (= (str.++ \"ab\" s) \"abc\"))\n"
+    "(assert (fp.lt r ((_ to_fp 8 24) RNE 1.5)))\n"
+    "(assert (fp.eq r (fp #b0 #x7f #b00000000000000000000000)))\n";
+
+static std::string to_string(Z3_context ctx, Z3_ast_vector v) {
+    return Z3_ast_vector_to_string(ctx, v);
+}
+
+void tst_ast_binary() {
+    char const * file_name = "tst_ast_binary.z3b";
+    Z3_context ctx1 = Z3_mk_context(nullptr);
+    Z3_solver s1 = Z3_mk_solver(ctx1);
+    Z3_solver_inc_ref(ctx1, s1);
+    Z3_solver_from_string(ctx1, s1, g_benchmark);
+    ENSURE(Z3_get_error_code(ctx1) == Z3_OK);
+    Z3_solver_to_binary_file(ctx1, s1, file_name);
+    ENSURE(Z3_get_error_code(ctx1) == Z3_OK);
+
+    // loading into the same context yields the same ASTs.
+    Z3_ast_vector fmls1 = Z3_solver_get_assertions(ctx1, s1);
+    Z3_ast_vector_inc_ref(ctx1, fmls1);
+    Z3_ast_vector fmls2 = Z3_parse_binary_file(ctx1, file_name);
+    Z3_ast_vector_inc_ref(ctx1, fmls2);
+    ENSURE(Z3_get_error_code(ctx1) == Z3_OK);
+    ENSURE(Z3_ast_vector_size(ctx1, fmls1) == Z3_ast_vector_size(ctx1, fmls2));
+    for (unsigned i = 0; i < Z3_ast_vector_size(ctx1, fmls1); ++i)
+        ENSURE(Z3_is_eq_ast(ctx1, Z3_ast_vector_get(ctx1, fmls1, i), Z3_ast_vector_get(ctx1, fmls2, i)));
+
+    // loading into a fresh context, including the datatype definition.
+    Z3_context ctx2 = Z3_mk_context(nullptr);
+    Z3_solver s2 = Z3_mk_solver(ctx2);
+    Z3_solver_inc_ref(ctx2, s2);
+    Z3_solver_from_file(ctx2, s2, file_name);
+    ENSURE(Z3_get_error_code(ctx2) == Z3_OK);
+    Z3_ast_vector fmls3 = Z3_solver_get_assertions(ctx2, s2);
+    Z3_ast_vector_inc_ref(ctx2, fmls3);
+    ENSURE(to_string(ctx1, fmls1) == to_string(ctx2, fmls3));
+    ENSURE(Z3_solver_check(ctx1, s1) == Z3_solver_check(ctx2, s2));
+
+    // corrupt files are rejected.
+    FILE * out = fopen(file_name, "wb");
+    ENSURE(out);
+    fputs("Z3AB\x01\x09", out);
+    fclose(out);
+    Z3_set_error_handler(ctx2, nullptr);
+    Z3_ast_vector fmls4 = Z3_parse_binary_file(ctx2, file_name);
+    ENSURE(Z3_get_error_code(ctx2) == Z3_PARSER_ERROR);
+    Z3_ast_vector_inc_ref(ctx2, fmls4);
+    ENSURE(Z3_ast_vector_size(ctx2, fmls4) == 0);
+
+    // theory sorts with invalid parameters are rejected: a bit-vector sort without a size.
+    static char const bad_sort[] = "Z3AB\x01\x01\x02\x02" "bv" "\x02\x02\x02" "bv" "\x01\x01\x00\x02\x00\x00\x09\x01\x01";
+    out = fopen(file_name, "wb");
+    ENSURE(out);
+    fwrite(bad_sort, 1, sizeof(bad_sort) - 1, out);
+    fclose(out);
+    Z3_ast_vector fmls5 = Z3_parse_binary_file(ctx2, file_name);
+    ENSURE(Z3_get_error_code(ctx2) == Z3_PARSER_ERROR);
+    Z3_ast_vector_inc_ref(ctx2, fmls5);
+    ENSURE(Z3_ast_vector_size(ctx2, fmls5) == 0);
+
+    std::remove(file_name);
+    Z3_ast_vector_dec_ref(ctx2, fmls5);
+    Z3_ast_vector_dec_ref(ctx2, fmls4);
+    Z3_ast_vector_dec_ref(ctx2, fmls3);
+    Z3_solver_dec_ref(ctx2, s2);
+    Z3_del_context(ctx2);
+    Z3_ast_vector_dec_ref(ctx1, fmls2);
+    Z3_ast_vector_dec_ref(ctx1, fmls1);
+    Z3_solver_dec_ref(ctx1, s1);
+    Z3_del_context(ctx1);
+}
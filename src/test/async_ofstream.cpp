@@ -0,0 +1,93 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    async_ofstream.cpp
+
+Abstract:
+
+    Test the background file writer: output arrives in order, across
+    many small blocks, and failures to open or write the file are
+    reported when the stream is flushed or closed.
+
+--*/
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdio>
+#include "util/async_ofstream.h"
+#include "util/util.h"
+
+static std::string read_file(char const* file_name) {
+    std::ifstream in(file_name, std::ios_base::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+static void tst_roundtrip(std::ios_base::openmode mode) {
+    char const* file_name = "tst_async_ofstream.out";
+    std::string expected;
+    {
+        // small blocks, so that the producer has to wait for the writer.
+        async_ofstream out(file_name, mode, 64);
+        ENSURE(out.is_open());
+        random_gen r(0);
+        for (unsigned i = 0; i < 20000; ++i) {
+            std::string line = std::to_string(i) + " " + std::to_string(r()) + "\n";
+            out << line;
+            expected += line;
+            if (i % 1000 == 0) {
+                char c = static_cast<char>(r(256));
+                out.write(&c, 1);
+                expected += c;
+            }
+            if (i % 5000 == 0) {
+                out.flush();
+                ENSURE(out.good());
+                ENSURE(read_file(file_name) == expected);
+            }
+        }
+        out.close();
+        ENSURE(!out.fail());
+    }
+    ENSURE(read_file(file_name) == expected);
+    std::remove(file_name);
+}
+
+static void tst_open_failure() {
+    async_ofstream out("tst_async_ofstream_missing_dir/proof.out");
+    ENSURE(!out.is_open());
+    out << "0\n";
+    out.close();
+    ENSURE(out.fail());
+}
+
+// writes to /dev/full fail once the data reaches the file.
+static void tst_write_failure() {
+    if (!std::ifstream("/dev/full").good())
+        return;
+    {
+        async_ofstream out("/dev/full", std::ios_base::out, 64);
+        ENSURE(out.is_open());
+        for (unsigned i = 0; i < 100 && out.good(); ++i)
+            out << "1 -2 3 0\n";
+        out.flush();
+        ENSURE(out.fail());
+    }
+    {
+        async_ofstream out("/dev/full");
+        out << "1 -2 3 0\n";
+        out.close();
+        ENSURE(out.fail());
+    }
+}
+
+void tst_async_ofstream() {
+    tst_roundtrip(std::ios_base::out);
+    tst_roundtrip(std::ios_base::binary | std::ios_base::out | std::ios_base::trunc);
+    tst_open_failure();
+    tst_write_failure();
+}
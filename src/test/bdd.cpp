@@ -1,4 +1,5 @@
 #include "math/dd/dd_bdd.h"
+#include "util/timer.h"
 
 namespace dd {
     static void test1() {
@@ -73,6 +74,57 @@ namespace dd {
         std::cout << c1 << "\n";
         std::cout << c1.bdd_size() << "\n";
     }
+
+    /**
+       Build the n-queens constraints and report bdd operations per second.
+       The number of operations counts the calls to the manager.
+     */
+    static bdd queens(bdd_manager& m, unsigned n, unsigned& num_ops) {
+        auto x = [&](unsigned i, unsigned j) { return m.mk_var(i * n + j); };
+        bdd r = m.mk_true();
+        for (unsigned i = 0; i < n; ++i) {
+            bdd row = m.mk_false();
+            for (unsigned j = 0; j < n; ++j, ++num_ops)
+                row = row || x(i, j);
+            r = r && row;
+            ++num_ops;
+        }
+        for (unsigned i = 0; i < n; ++i) {
+            for (unsigned j = 0; j < n; ++j) {
+                bdd none = m.mk_true();
+                for (unsigned k = 0; k < n; ++k) {
+                    for (unsigned l = 0; l < n; ++l) {
+                        if (k == i && l == j)
+                            continue;
+                        bool attacks = k == i || l == j || k + j == i + l || k + l == i + j;
+                        if (!attacks)
+                            continue;
+                        none = none && !x(k, l);
+                        num_ops += 2;
+                    }
+                }
+                r = r && (!x(i, j) || none);
+                num_ops += 3;
+            }
+        }
+        return r;
+    }
+
+    static void bench_queens(unsigned n) {
+        bdd_manager m1(n * n), m2(n * n);
+        // a tiny cache forces collisions but must not change results
+        m2.set_max_op_cache_memory(64 * 1024);
+        unsigned num_ops = 0;
+        timer t;
+        bdd q1 = queens(m1, n, num_ops);
+        double secs = t.get_seconds();
+        std::cout << "queens " << n << " bdd size: " << q1.bdd_size() << " ops: " << num_ops
+                  << " time: " << secs << "s ops/sec: " << (secs > 0 ? num_ops / secs : 0) << "\n";
+        unsigned num_ops2 = 0;
+        bdd q2 = queens(m2, n, num_ops2);
+        ENSURE(q1.bdd_size() == q2.bdd_size());
+        ENSURE(q1.dnf_size() == q2.dnf_size());
+    }
 }
 
 void tst_bdd() {
@@ -80,4 +132,6 @@ void tst_bdd() {
     dd::test2();
     dd::test3();
     dd::test4();
+    dd::bench_queens(6);
+    dd::bench_queens(7);
 }
@@ -3,6 +3,9 @@ Copyright (c) 2020 Microsoft Corporation
 
 --*/
 
+#include <cstdlib>
+#include <map>
+#include <tuple>
 #include "util/util.h"
 #include "util/timer.h"
 #include "ast/euf/euf_egraph.h"
@@ -129,9 +132,109 @@ static void test3() {
         std::cout << "conflict: " << *j << "\n";
 }
 
+/**
+   Every pair of congruent applications has the same root.
+   Arguments of commutative applications are compared in either order.
+*/
+static void check_congruences(euf::enode_vector const& apps) {
+    std::map<std::tuple<func_decl*, euf::enode*, euf::enode*>, euf::enode*> roots;
+    for (euf::enode* n : apps) {
+        euf::enode* a = n->get_arg(0)->get_root();
+        euf::enode* b = n->num_args() == 2 ? n->get_arg(1)->get_root() : nullptr;
+        if (b && n->get_decl()->is_commutative() && b->get_expr_id() < a->get_expr_id())
+            std::swap(a, b);
+        auto key = std::make_tuple(n->get_decl(), a, b);
+        auto it = roots.find(key);
+        if (it == roots.end())
+            roots.emplace(key, n->get_root());
+        else
+            VERIFY(it->second == n->get_root());
+    }
+}
+
+/**
+   Random merges of constants under unary, binary and commutative
+   applications, with backtracking.
+   If check is false, the congruences are not checked and the number
+   of merges per second is reported instead.
+*/
+static void test4(unsigned seed, unsigned num_consts, unsigned num_apps, bool check = true) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    euf::egraph g(m);
+    random_gen r(seed);
+    sort_ref S(m.mk_uninterpreted_sort(symbol("S")), m);
+    sort* dom[2] = { S.get(), S.get() };
+    func_decl_info info;
+    info.set_commutative();
+    func_decl_ref f(m.mk_func_decl(symbol("f"), 1, dom, S), m);
+    func_decl_ref h(m.mk_func_decl(symbol("h"), 2, dom, S), m);
+    func_decl_ref c(m.mk_func_decl(symbol("c"), 2, dom, S, info), m);
+    expr_ref_vector pinned(m);
+    euf::enode_vector consts, nodes;
+    for (unsigned i = 0; i < num_consts; ++i) {
+        std::string xn("x");
+        xn += std::to_string(i);
+        expr_ref x = mk_const(m, xn.c_str(), S);
+        pinned.push_back(x);
+        consts.push_back(g.mk(x, 0, 0, nullptr));
+    }
+    nodes.append(consts);
+    for (unsigned i = 0; i < num_apps; ++i) {
+        euf::enode* args[2] = { nodes[r(nodes.size())], nodes[r(nodes.size())] };
+        func_decl* d = r(3) == 0 ? f.get() : (r(2) == 0 ? h.get() : c.get());
+        expr* es[2] = { args[0]->get_expr(), args[1]->get_expr() };
+        expr_ref e(m.mk_app(d, d->get_arity(), es), m);
+        pinned.push_back(e);
+        nodes.push_back(g.mk(e, 0, d->get_arity(), args));
+    }
+    euf::enode_vector apps(num_apps, nodes.data() + num_consts);
+    auto check_apps = [&]() {
+        if (check)
+            check_congruences(apps);
+    };
+    g.propagate();
+    check_apps();
+    unsigned num_merges = 0;
+    timer t;
+    for (unsigned round = 0; round < 10; ++round) {
+        g.push();
+        for (unsigned i = 0; i < num_consts / 2; ++i) {
+            g.merge(consts[r(num_consts)], consts[r(num_consts)], nullptr);
+            ++num_merges;
+            if (i % 16 == 0) {
+                g.propagate();
+                check_apps();
+            }
+        }
+        g.propagate();
+        check_apps();
+        g.pop(1);
+        check_apps();
+    }
+    double secs = t.get_seconds();
+    for (euf::enode* n : consts)
+        VERIFY(n->get_root() == n);
+    if (!check)
+        std::cout << "consts: " << num_consts << " apps: " << num_apps << " merges: " << num_merges
+                  << " time: " << secs << "s merges/sec: " << (secs > 0 ? num_merges / secs : 0) << "\n";
+}
+
+// congruence closure benchmark with 10 * num_consts applications.
+// usage: egraph_bench [num_consts]
+void tst_egraph_bench(char** argv, int argc, int& i) {
+    unsigned num_consts = 10000;
+    if (i + 1 < argc)
+        num_consts = atoi(argv[++i]);
+    for (unsigned seed = 0; seed < 3; ++seed)
+        test4(seed, num_consts, 10 * num_consts, false);
+}
+
 void tst_egraph() {
     enable_trace("euf");
     test3();
     test1();
     test2();
+    test4(0, 100, 1000);
+    test4(1, 1000, 10000);
 }
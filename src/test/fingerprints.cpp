@@ -0,0 +1,92 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    fingerprints.cpp
+
+Abstract:
+
+    Test the fingerprint table against a reference set, with scopes
+    that are large enough to grow the table and to rebuild its Bloom filter.
+
+--*/
+
+#include <set>
+#include <vector>
+#include "smt/fingerprints.h"
+#include "ast/reg_decl_plugins.h"
+#include "util/util.h"
+
+typedef std::vector<unsigned> fp_key;
+
+static void tst_fingerprints(unsigned seed) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    region r;
+    smt::app2enode_t app2enode;
+    app_ref_vector consts(m);
+    ptr_vector<smt::enode> nodes;
+    for (unsigned i = 0; i < 64; ++i) {
+        consts.push_back(m.mk_fresh_const("c", m.mk_bool_sort()));
+        nodes.push_back(smt::enode::mk(m, r, app2enode, consts.back(), 0, false, false, 0, true, false));
+    }
+    int data[4];
+    smt::fingerprint_set fps(m, r);
+    std::set<fp_key> ref;
+    std::vector<fp_key> trail;
+    std::vector<unsigned> scopes;
+    random_gen rand(seed);
+    for (unsigned i = 0; i < 40000; ++i) {
+        unsigned d = rand(4);
+        unsigned num_args = 1 + rand(3);
+        smt::enode * args[3];
+        fp_key k;
+        k.push_back(d);
+        for (unsigned j = 0; j < num_args; ++j) {
+            k.push_back(rand(nodes.size()));
+            args[j] = nodes[k.back()];
+        }
+        bool in_ref = ref.count(k) > 0;
+        unsigned op = rand(100);
+        if (op < 70) {
+            smt::fingerprint * f = fps.insert(data + d, d, num_args, args, nullptr);
+            ENSURE((f == nullptr) == in_ref);
+            if (!in_ref) {
+                ENSURE(f->get_data() == data + d && f->get_num_args() == num_args);
+                ref.insert(k);
+                trail.push_back(k);
+            }
+        }
+        else if (op < 97) {
+            ENSURE(fps.contains(data + d, d, num_args, args) == in_ref);
+        }
+        else if (op < 99 || scopes.empty()) {
+            fps.push_scope();
+            scopes.push_back(trail.size());
+        }
+        else {
+            // mostly pop a single scope, sometimes everything to make the filter stale.
+            unsigned n = rand(32) == 0 ? scopes.size() : 1;
+            fps.pop_scope(n);
+            unsigned old_size = scopes[scopes.size() - n];
+            scopes.resize(scopes.size() - n);
+            while (trail.size() > old_size) {
+                ref.erase(trail.back());
+                trail.pop_back();
+            }
+        }
+        ENSURE(fps.size() == trail.size());
+    }
+    for (fp_key const & k : trail) {
+        smt::enode * args[3];
+        for (unsigned j = 1; j < k.size(); ++j)
+            args[j - 1] = nodes[k[j]];
+        ENSURE(fps.contains(data + k[0], k[0], k.size() - 1, args));
+    }
+}
+
+void tst_fingerprints() {
+    for (unsigned seed = 0; seed < 4; ++seed)
+        tst_fingerprints(seed);
+}
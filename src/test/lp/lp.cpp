@@ -2206,6 +2206,8 @@ void setup_args_parser(argument_parser & parser) {
     parser.add_option_with_help_string("--row_inf", "forces row infeasibility search");
     parser.add_option_with_help_string("-pd", "presolve with double solver");
     parser.add_option_with_help_string("--test_int_set", "test int_set");
+    parser.add_option_with_help_string("--test_pivot_int64", "test pivoting of small and overflowing integer coefficients");
+    parser.add_option_with_help_string("--bench_pivot_int64", "time pivoting of small integer coefficients with and without the int64 path, and of large coefficients");
     parser.add_option_with_help_string("--test_mpq", "test rationals");
     parser.add_option_with_help_string("--test_mpq_np", "test rationals");
     parser.add_option_with_help_string("--test_mpq_np_plus", "test rationals using plus instead of +=");
@@ -3237,6 +3239,98 @@ void test_int_set() {
     
 }
 
+void test_pivot_int64() {
+    mpq big(int64_t(1) << 40, mpq::i64());
+    mpq a[] = { mpq(3), big, mpq(-5), big * big };
+    mpq b[] = { mpq(7), big, mpq(2, 3), big };
+    for (unsigned k = 0; k < 4; k++) {
+        static_matrix<mpq, mpq> m(2, 4);
+        m.set(0, 0, mpq(1));
+        m.set(0, 1, a[k]);
+        m.set(0, 2, mpq(4));
+        m.set(1, 0, b[k]);
+        m.set(1, 1, mpq(11));
+        m.set(1, 3, mpq(-1));
+        column_cell & c = m.m_columns[0][0].var() == 1 ? m.m_columns[0][0] : m.m_columns[0][1];
+        VERIFY(m.pivot_row_to_row_given_cell(0, c, 0));
+        VERIFY(is_zero(m.get_elem(1, 0)));
+        VERIFY(m.get_elem(1, 1) == mpq(11) - b[k] * a[k]);
+        VERIFY(m.get_elem(1, 2) == - b[k] * mpq(4));
+        VERIFY(m.get_elem(1, 3) == mpq(-1));
+        lp_assert(m.is_correct());
+    }
+}
+
+// static_matrix::pivot_row_to_row_given_cell without the int64 fast path,
+// the baseline for bench_pivot_int64.
+bool pivot_row_to_row_with_rationals(static_matrix<mpq, mpq> & m, unsigned i, column_cell & c, unsigned pivot_col) {
+    unsigned ii = c.var();
+    mpq alpha = -m.get_val(c);
+    auto & rowii = m.m_rows[ii];
+    m.remove_element(rowii, rowii[c.offset()]);
+    for (unsigned k = 0; k < rowii.size(); k++)
+        m.m_vector_of_row_offsets[rowii[k].var()] = k;
+    unsigned prev_size_ii = rowii.size();
+    for (const auto & iv : m.m_rows[i]) {
+        unsigned j = iv.var();
+        if (j == pivot_col) continue;
+        int j_offs = m.m_vector_of_row_offsets[j];
+        if (j_offs == -1)
+            m.set(ii, j, alpha * iv.coeff());
+        else
+            rowii[j_offs].coeff().addmul(iv.coeff(), alpha);
+    }
+    for (unsigned k = 0; k < prev_size_ii; k++)
+        m.m_vector_of_row_offsets[rowii[k].var()] = -1;
+    for (unsigned k = rowii.size(); k-- > 0;  ) {
+        if (is_zero(rowii[k].coeff()))
+            m.remove_element(rowii, rowii[k]);
+    }
+    return !rowii.empty();
+}
+
+// pivot the first row into all other rows of a random tableau
+// whose coefficients are small integers multiplied by scale.
+// The tableau only depends on the dimensions and on scale.
+double bench_pivot(unsigned num_rows, unsigned num_cols, mpq const & scale, bool baseline) {
+    g_rand.set_seed(num_rows);
+    static_matrix<mpq, mpq> m(num_rows, num_cols);
+    m.set(0, 0, mpq(1));
+    for (unsigned i = 0; i < num_rows; i++) {
+        if (i > 0)
+            m.set(i, 0, scale * mpq(1 + static_cast<int>(my_random() % 10)));
+        // the pivot row is dense, so that each pivot updates many cells
+        for (unsigned k = 0; k < (i == 0 ? num_cols / 4 : 8); k++) {
+            unsigned j = 1 + my_random() % (num_cols - 1);
+            int v = 1 + static_cast<int>(my_random() % 10);
+            if (is_zero(m.get_elem(i, j)))
+                m.set(i, j, scale * mpq(my_random() % 2 == 0 ? v : -v));
+        }
+    }
+    stopwatch sw;
+    sw.start();
+    auto & col = m.m_columns[0];
+    while (col.size() > 1) {
+        column_cell & c = col[0].var() == 0 ? col[1] : col[0];
+        bool nonempty = baseline ? pivot_row_to_row_with_rationals(m, 0, c, 0) : m.pivot_row_to_row_given_cell(0, c, 0);
+        VERIFY(nonempty);
+    }
+    sw.stop();
+    return sw.get_seconds();
+}
+
+void bench_pivot_int64() {
+    mpq big(int64_t(1) << 40, mpq::i64());
+    std::cout << "sizeof(row_cell<mpq>) " << sizeof(row_cell<mpq>) << std::endl;
+    for (unsigned round = 0; round < 3; round++) {
+        double fast_time = bench_pivot(20000, 2000, mpq(1), false);
+        double baseline_time = bench_pivot(20000, 2000, mpq(1), true);
+        double large_time = bench_pivot(20000, 2000, big, false);
+        std::cout << "pivot small integers " << fast_time << "s, without the int64 path " << baseline_time
+                  << "s, large integers " << large_time << "s" << std::endl;
+    }
+}
+
 void test_rationals_no_numeric_pairs() {
     stopwatch sw;
 
@@ -3969,6 +4063,14 @@ void test_lp_local(int argn, char**argv) {
         test_int_set();
         return finalize(0);
     }
+    if (args_parser.option_is_used("--test_pivot_int64")) {
+        test_pivot_int64();
+        return finalize(0);
+    }
+    if (args_parser.option_is_used("--bench_pivot_int64")) {
+        bench_pivot_int64();
+        return finalize(0);
+    }
     if (args_parser.option_is_used("--bp")) {
         test_bound_propagation();
         return finalize(0);
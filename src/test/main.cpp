@@ -156,6 +156,8 @@ int main(int argc, char ** argv) {
     TST(rational);
     TST(inf_rational);
     TST(ast);
+    TST(ast_binary);
+    TST(async_ofstream);
     TST(optional);
     TST(bit_vector);
     TST(fixed_bit_vector);
@@ -169,6 +171,7 @@ int main(int argc, char ** argv) {
     TST_ARGV(expr_rand);
     TST(list);
     TST(small_object_allocator);
+    TST(memory_threads);
     TST(timeout);
     TST(proof_checker);
     TST(simplifier);
@@ -197,17 +200,24 @@ int main(int argc, char ** argv) {
     TST(buffer);
     TST(chashtable);
     TST(egraph);
+    TST_ARGV(egraph_bench);
+    TST(fingerprints);
     TST(ex);
     TST(nlarith_util);
     TST(api_bug);
     TST(arith_rewriter);
     TST(check_assumptions);
+    TST(solver_snapshot);
+    TST(smt_cg_table);
     TST(smt_context);
+    TST(smt_context_relevancy);
+    TST(smt_context_lra);
     TST(theory_dl);
     TST(model_retrieval);
     TST(model_based_opt);
     TST(factor_rewriter);
     TST(smt2print_parse);
+    TST_ARGV(smt2_parse_threads);
     TST(substitution);
     TST(polynomial);
     TST(upolynomial);
@@ -248,6 +258,14 @@ int main(int argc, char ** argv) {
     TST(theory_pb);
     TST(simplex);
     TST(sat_user_scope);
+    TST(sat_propagate);
+    TST_ARGV(sat_propagate_bench);
+    TST(sat_ddfw);
+    TST_ARGV(sat_ddfw_bench);
+    TST(sat_elim_vars);
+    TST(sat_gc);
+    TST(sat_reuse_trail);
+    TST(sat_vivify);
     TST_ARGV(ddnf);
     TST(ddnf1);
     TST(model_evaluator);
@@ -262,4 +280,6 @@ int main(int argc, char ** argv) {
     TST(solver_pool);
     //TST_ARGV(hs);
     TST(finder);
+    TST_ARGV(smt_context_enodes);
+    TST_ARGV(smt_context_lra_bench);
 }
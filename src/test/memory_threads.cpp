@@ -0,0 +1,129 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    memory_threads.cpp
+
+Abstract:
+
+    Allocate, reallocate and free blocks of mixed sizes from several threads,
+    where blocks are also freed by threads other than the one that allocated them.
+    When Z3_THREAD_CACHE_ALLOC is defined this exercises the per-thread caches,
+    the global pool and the release of caches by exiting threads.
+
+--*/
+
+#ifndef SINGLE_THREAD
+#include <thread>
+#include <mutex>
+#include <cstring>
+#include "util/memory_manager.h"
+#include "util/vector.h"
+#include "util/util.h"
+
+namespace {
+    struct block {
+        unsigned char * m_data;
+        size_t          m_size;
+        unsigned char   m_tag;
+    };
+
+    void fill(block const & b) {
+        memset(b.m_data, b.m_tag, b.m_size);
+    }
+
+    void check(block const & b) {
+        for (size_t i = 0; i < b.m_size; ++i)
+            ENSURE(b.m_data[i] == b.m_tag);
+    }
+
+    // sizes around the size classes and above the largest cached block.
+    size_t random_size(random_gen & r) {
+        switch (r(4)) {
+        case 0: return 1 + r(16);
+        case 1: return 1 + r(256);
+        case 2: return 1 + r(1100);
+        default: return 1 + r(5000);
+        }
+    }
+
+    block mk_block(random_gen & r) {
+        block b;
+        b.m_size = random_size(r);
+        b.m_data = static_cast<unsigned char*>(memory::allocate(b.m_size));
+        b.m_tag = static_cast<unsigned char>(r(256));
+        fill(b);
+        return b;
+    }
+}
+
+static void worker(unsigned seed, std::mutex & mux, vector<block> & exchange) {
+    random_gen r(seed);
+    vector<block> live;
+    for (unsigned i = 0; i < 30000; ++i) {
+        unsigned op = r(10);
+        if (op < 5 || live.empty()) {
+            live.push_back(mk_block(r));
+        }
+        else {
+            unsigned j = r(live.size());
+            block b = live[j];
+            check(b);
+            if (op == 5) {
+                // grow or shrink, possibly across the largest cached size.
+                size_t sz = random_size(r);
+                b.m_data = static_cast<unsigned char*>(memory::reallocate(b.m_data, sz));
+                b.m_size = std::min(b.m_size, sz);
+                check(b);
+                b.m_size = sz;
+                fill(b);
+                live[j] = b;
+                continue;
+            }
+            live[j] = live.back();
+            live.pop_back();
+            if (op < 8) {
+                memory::deallocate(b.m_data);
+                continue;
+            }
+            // trade the block for one allocated by another thread.
+            std::lock_guard<std::mutex> lock(mux);
+            exchange.push_back(b);
+            if (exchange.size() > 1) {
+                unsigned k = r(exchange.size());
+                block o = exchange[k];
+                exchange[k] = exchange.back();
+                exchange.pop_back();
+                check(o);
+                memory::deallocate(o.m_data);
+            }
+        }
+    }
+    for (block const & b : live) {
+        check(b);
+        memory::deallocate(b.m_data);
+    }
+}
+
+void tst_memory_threads() {
+    std::mutex mux;
+    vector<block> exchange;
+    // later rounds run on new threads that reuse the blocks released by the exited ones.
+    for (unsigned round = 0; round < 4; ++round) {
+        unsigned num_threads = 2 + round;
+        vector<std::thread> threads(num_threads);
+        for (unsigned t = 0; t < num_threads; ++t)
+            threads[t] = std::thread([&, t]() { worker(round * 16 + t, mux, exchange); });
+        for (auto & th : threads)
+            th.join();
+    }
+    for (block const & b : exchange) {
+        check(b);
+        memory::deallocate(b.m_data);
+    }
+}
+#else
+void tst_memory_threads() {
+}
+#endif
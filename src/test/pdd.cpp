@@ -1,4 +1,6 @@
 #include "math/dd/dd_pdd.h"
+#include "util/timer.h"
+#include "util/util.h"
 
 namespace dd {
 
@@ -322,6 +324,48 @@ public :
         SASSERT(!(2*a*b + 3*b + 2).is_non_zero());
     }
 
+    /**
+       Multiply and add random polynomials and report pdd operations per second.
+     */
+    static pdd random_ops(pdd_manager& m, unsigned seed, unsigned num_rounds, unsigned& num_ops) {
+        random_gen r(seed);
+        unsigned n = m.num_vars();
+        vector<pdd> ps;
+        for (unsigned i = 0; i < 8; ++i)
+            ps.push_back(m.mk_var(r(n)) + m.mk_var(r(n)) * rational(static_cast<int>(r(5)) + 1) + rational(-static_cast<int>(r(3))));
+        for (unsigned i = 0; i < num_rounds; ++i) {
+            pdd & p = ps[r(ps.size())];
+            pdd const& q = ps[r(ps.size())];
+            if (r(3) == 0 && p.degree() < 6)
+                p = p * q;
+            else
+                p = p + q * m.mk_var(r(n));
+            ++num_ops;
+            // keep the polynomials small
+            if (p.tree_size() > 2000)
+                p = m.mk_var(r(n));
+        }
+        pdd result = m.zero();
+        for (pdd const& p : ps)
+            result = result + p;
+        return result;
+    }
+
+    static void bench_ops() {
+        for (unsigned seed = 0; seed < 2; ++seed) {
+            pdd_manager m1(12), m2(12);
+            // a tiny cache forces collisions but must not change results
+            m2.set_max_op_cache_memory(64 * 1024);
+            unsigned num_ops = 0, num_ops2 = 0;
+            timer t;
+            pdd p1 = random_ops(m1, seed, 1000, num_ops);
+            double secs = t.get_seconds();
+            std::cout << "pdd ops: " << num_ops << " time: " << secs << "s ops/sec: " << (secs > 0 ? num_ops / secs : 0) << "\n";
+            pdd p2 = random_ops(m2, seed, 1000, num_ops2);
+            ENSURE(p1 == m1.translate(p2));
+        }
+    }
+
 };
 
 }
@@ -336,4 +380,5 @@ void tst_pdd() {
     dd::test::order();
     dd::test::order_lm();
     dd::test::mod4_operations();
+    dd::test::bench_ops();
 }
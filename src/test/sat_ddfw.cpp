@@ -0,0 +1,97 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    sat_ddfw.cpp
+
+Abstract:
+
+    Test the ddfw local search solver on random 3-SAT instances with
+    a planted solution. sat_ddfw_bench times it on larger instances.
+
+--*/
+
+#include <iostream>
+#include "sat/sat_solver.h"
+#include "sat/sat_ddfw.h"
+#include "util/stopwatch.h"
+#include "util/statistics.h"
+#include "util/util.h"
+
+static void add_planted(sat::solver& s, unsigned seed, unsigned num_vars, double ratio, vector<sat::literal_vector>& clauses) {
+    random_gen r(seed);
+    bool_vector planted;
+    for (unsigned i = 0; i < num_vars; ++i) {
+        s.mk_var();
+        planted.push_back(r(2) == 0);
+    }
+    unsigned num_clauses = static_cast<unsigned>(ratio * num_vars);
+    while (clauses.size() < num_clauses) {
+        sat::literal_vector cls;
+        bool sat = false;
+        while (cls.size() < 3) {
+            sat::literal lit(r(num_vars), r(2) == 0);
+            if (cls.contains(lit) || cls.contains(~lit))
+                continue;
+            cls.push_back(lit);
+            sat |= planted[lit.var()] != lit.sign();
+        }
+        if (!sat)
+            continue;
+        clauses.push_back(cls);
+        s.mk_clause(cls.size(), cls.data());
+    }
+}
+
+static lbool run_ddfw(unsigned seed, unsigned num_vars, double ratio, bool verbose) {
+    params_ref p;
+    reslimit rlim;
+    sat::solver s(p, rlim);
+    vector<sat::literal_vector> clauses;
+    add_planted(s, seed, num_vars, ratio, clauses);
+
+    sat::ddfw ddfw;
+    // the planted assignment and the initial assignment of ddfw use separate random streams.
+    ddfw.set_seed(seed + 1000);
+    ddfw.add(s);
+    stopwatch sw;
+    sw.start();
+    lbool is_sat;
+    {
+        scoped_rlimit _rlimit(ddfw.rlimit(), 10000000);
+        is_sat = ddfw.check(0, nullptr, nullptr);
+    }
+    sw.stop();
+    if (verbose) {
+        statistics st;
+        ddfw.collect_statistics(st);
+        std::cout << "vars: " << num_vars << " ratio: " << ratio << " result: " << is_sat << " time: " << sw.get_seconds() << "s\n";
+        st.display(std::cout);
+    }
+
+    if (is_sat == l_true) {
+        sat::model const& m = ddfw.get_model();
+        for (auto const& cls : clauses) {
+            bool found = false;
+            for (sat::literal lit : cls)
+                found |= sat::value_at(lit, m) == l_true;
+            ENSURE(found);
+        }
+    }
+    return is_sat;
+}
+
+// ddfw finds a model of small planted instances well within the resource limit.
+void tst_sat_ddfw() {
+    for (unsigned seed = 0; seed < 5; ++seed)
+        ENSURE(run_ddfw(seed, 200, 4.0, false) == l_true);
+}
+
+// usage: sat_ddfw_bench
+// larger instances may end with l_undef when the resource limit is reached.
+void tst_sat_ddfw_bench(char** argv, int argc, int& i) {
+    run_ddfw(0, 1000, 3.5, true);
+    run_ddfw(1, 20000, 3.5, true);
+    run_ddfw(2, 5000, 4.2, true);
+}
@@ -0,0 +1,90 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    sat_elim_vars.cpp
+
+Abstract:
+
+    Test that bounded variable elimination eliminates the same variables
+    for any value of sat.elim_vars.threads, and that models of the simplified
+    instances extend to models of the original clauses.
+
+--*/
+
+#include "sat/sat_solver.h"
+#include "util/util.h"
+
+static void mk_instance(unsigned seed, unsigned num_vars, vector<sat::literal_vector>& clauses) {
+    random_gen r(seed);
+    for (unsigned i = 0; i < 3 * num_vars; ++i) {
+        sat::literal_vector cls;
+        // mostly ternary clauses with a few binary and long ones.
+        unsigned sz = 3;
+        switch (r(6)) {
+        case 0: sz = 2; break;
+        case 1: sz = 4 + r(3); break;
+        default: break;
+        }
+        while (cls.size() < sz) {
+            sat::literal lit(r(num_vars), r(2) == 0);
+            if (!cls.contains(lit) && !cls.contains(~lit))
+                cls.push_back(lit);
+        }
+        clauses.push_back(cls);
+    }
+}
+
+static void tst_elim_vars(unsigned seed, unsigned num_vars) {
+    vector<sat::literal_vector> clauses;
+    mk_instance(seed, num_vars, clauses);
+    bool_vector eliminated0;
+    unsigned num_clauses0 = 0;
+    lbool is_sat0 = l_undef;
+    for (unsigned threads : { 1, 2, 4, 7 }) {
+        params_ref p;
+        p.set_uint("elim_vars.threads", threads);
+        reslimit rlim;
+        sat::solver s(p, rlim);
+        for (unsigned i = 0; i < num_vars; ++i)
+            s.mk_var();
+        for (auto const& cls : clauses)
+            s.mk_clause(cls.size(), cls.data());
+        s.simplify(false);
+        bool_vector eliminated;
+        unsigned num_elim = 0;
+        for (unsigned v = 0; v < num_vars; ++v) {
+            eliminated.push_back(s.was_eliminated(v));
+            num_elim += eliminated.back();
+        }
+        if (threads == 1) {
+            ENSURE(num_elim > 0);
+            eliminated0 = eliminated;
+            num_clauses0 = s.num_clauses();
+        }
+        else {
+            ENSURE(eliminated == eliminated0);
+            ENSURE(s.num_clauses() == num_clauses0);
+        }
+        lbool is_sat = s.check();
+        ENSURE(is_sat != l_undef);
+        if (threads == 1)
+            is_sat0 = is_sat;
+        ENSURE(is_sat == is_sat0);
+        if (is_sat == l_true) {
+            sat::model const& m = s.get_model();
+            for (auto const& cls : clauses) {
+                bool found = false;
+                for (sat::literal lit : cls)
+                    found |= value_at(lit, m) == l_true;
+                ENSURE(found);
+            }
+        }
+    }
+}
+
+void tst_sat_elim_vars() {
+    for (unsigned seed = 0; seed < 10; ++seed)
+        tst_elim_vars(seed, 50 + 20 * seed);
+}
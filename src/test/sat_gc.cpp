@@ -0,0 +1,101 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    sat_gc.cpp
+
+Abstract:
+
+    Test tiered garbage collection of learned clauses (sat.gc=tiered):
+    promotion to the core and tier 2, demotion of unused clauses, aging
+    of unused core clauses and deletion of the worse local clauses.
+
+--*/
+
+#include "sat/sat_solver.h"
+#include "util/util.h"
+
+namespace {
+    class gc_solver : public sat::solver {
+    public:
+        gc_solver(params_ref const& p, reslimit& l): sat::solver(p, l) {}
+        void gc() { gc_tiered(); }
+    };
+}
+
+static sat::clause* mk_learned(gc_solver& s, unsigned first, unsigned sz, unsigned glue) {
+    sat::literal_vector lits;
+    for (unsigned i = 0; i < sz; ++i)
+        lits.push_back(sat::literal(first + i, false));
+    sat::clause* c = s.mk_clause(lits, sat::status::redundant());
+    ENSURE(c && c->is_learned());
+    c->set_glue(glue);
+    return c;
+}
+
+static bool is_learned(gc_solver const& s, sat::clause const* c) {
+    return s.learned().contains(const_cast<sat::clause*>(c));
+}
+
+void tst_sat_gc() {
+    params_ref p;
+    p.set_sym("gc", symbol("tiered"));
+    p.set_uint("gc.tier1_glue", 2);
+    p.set_uint("gc.tier2_glue", 6);
+    p.set_uint("gc.tier1_rounds", 3);
+    reslimit rlim;
+    gc_solver s(p, rlim);
+    for (unsigned i = 0; i < 100; ++i)
+        s.mk_var();
+
+    sat::clause* core   = mk_learned(s, 0, 4, 2);
+    sat::clause* mid    = mk_learned(s, 10, 4, 5);
+    sat::clause* better = mk_learned(s, 20, 4, 9);
+    sat::clause* idle   = mk_learned(s, 30, 4, 4);
+    // local clauses with increasing glue; the worse half is deleted.
+    ptr_vector<sat::clause> local;
+    for (unsigned i = 0; i < 6; ++i)
+        local.push_back(mk_learned(s, 40 + 5 * i, 4, 10 + i));
+
+    core->mark_used();
+    mid->mark_used();
+    better->mark_used();
+    s.gc();
+    ENSURE(core->tier() == sat::TIER_CORE);
+    ENSURE(mid->tier() == sat::TIER_2);
+    ENSURE(better->tier() == sat::TIER_LOCAL);
+    // idle and local are candidates, the three with largest glue are deleted.
+    for (unsigned i = 0; i < 3; ++i)
+        ENSURE(is_learned(s, local[i]));
+    for (unsigned i = 3; i < 6; ++i)
+        ENSURE(!is_learned(s, local[i]));
+    ENSURE(is_learned(s, idle) && is_learned(s, better));
+
+    // a clause whose glue dropped while propagating moves to the core,
+    // an unused tier 2 clause is demoted.
+    better->mark_used();
+    better->set_glue(2);
+    core->mark_used();
+    s.gc();
+    ENSURE(better->tier() == sat::TIER_CORE);
+    ENSURE(mid->tier() == sat::TIER_LOCAL);
+    ENSURE(core->tier() == sat::TIER_CORE);
+
+    // core clauses are kept while they are used within gc.tier1_rounds
+    // collections, unused local clauses are deleted.
+    for (unsigned i = 0; i < 3; ++i) {
+        ENSURE(is_learned(s, core));
+        better->mark_used();
+        s.gc();
+    }
+    ENSURE(!is_learned(s, core));
+    ENSURE(is_learned(s, better));
+    ENSURE(better->tier() == sat::TIER_CORE);
+    ENSURE(!is_learned(s, mid));
+    for (sat::clause* c : local)
+        ENSURE(!is_learned(s, c));
+
+    // the remaining clauses are consistent with the watch lists.
+    ENSURE(s.check() == l_true);
+}
@@ -0,0 +1,167 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    sat_propagate.cpp
+
+Abstract:
+
+    Test the order of watches in SAT watch lists and propagation on
+    random instances that mix binary and long clauses.
+    sat_propagate_bench times the solver on larger instances of the
+    same kind.
+
+--*/
+
+#include <iostream>
+#include <cstdlib>
+#include "sat/sat_solver.h"
+#include "util/stopwatch.h"
+#include "util/statistics.h"
+#include "util/util.h"
+
+static bool binary_watches_first(sat::watch_list const& wlist) {
+    bool non_binary = false;
+    for (sat::watched const& w : wlist) {
+        if (!w.is_binary_clause())
+            non_binary = true;
+        else if (non_binary)
+            return false;
+    }
+    return true;
+}
+
+static void tst_push_binary_watch(unsigned seed) {
+    random_gen r(seed);
+    sat::watch_list wlist;
+    unsigned num_binary = 0;
+    for (unsigned i = 0; i < 200; ++i) {
+        sat::literal lit(r(50), r(2) == 0);
+        switch (r(3)) {
+        case 0:
+            sat::push_binary_watch(wlist, sat::watched(lit, r(2) == 0));
+            ++num_binary;
+            break;
+        case 1:
+            wlist.push_back(sat::watched(lit, static_cast<sat::clause_offset>(i)));
+            break;
+        default:
+            wlist.push_back(sat::watched(static_cast<sat::ext_constraint_idx>(i)));
+            break;
+        }
+        ENSURE(binary_watches_first(wlist));
+        ENSURE(i + 1 == wlist.size());
+    }
+    unsigned n = 0;
+    for (sat::watched const& w : wlist)
+        n += w.is_binary_clause();
+    ENSURE(n == num_binary);
+}
+
+static bool satisfies(unsigned assignment, vector<sat::literal_vector> const& clauses) {
+    for (auto const& cls : clauses) {
+        bool found = false;
+        for (sat::literal lit : cls)
+            found |= ((assignment >> lit.var()) & 1) != static_cast<unsigned>(lit.sign());
+        if (!found)
+            return false;
+    }
+    return true;
+}
+
+static bool satisfied(sat::model const& m, vector<sat::literal_vector> const& clauses) {
+    for (auto const& cls : clauses) {
+        bool found = false;
+        for (sat::literal lit : cls)
+            found |= value_at(lit, m) == l_true;
+        if (!found)
+            return false;
+    }
+    return true;
+}
+
+static void add_random_clause(sat::solver& s, random_gen& r, unsigned num_vars, unsigned sz, vector<sat::literal_vector>& clauses) {
+    sat::literal_vector cls;
+    while (cls.size() < sz) {
+        sat::literal lit(r(num_vars), r(2) == 0);
+        if (!cls.contains(lit) && !cls.contains(~lit))
+            cls.push_back(lit);
+    }
+    clauses.push_back(cls);
+    s.mk_clause(cls.size(), cls.data());
+}
+
+// compare the solver against enumerating all assignments.
+static lbool tst_random_instance(unsigned seed, unsigned num_vars, unsigned num_binary, unsigned num_long) {
+    params_ref p;
+    reslimit rlim;
+    sat::solver s(p, rlim);
+    random_gen r(seed);
+    vector<sat::literal_vector> clauses;
+    for (unsigned i = 0; i < num_vars; ++i)
+        s.mk_var();
+    for (unsigned i = 0; i < num_long; ++i)
+        add_random_clause(s, r, num_vars, 4, clauses);
+    for (unsigned i = 0; i < num_binary; ++i)
+        add_random_clause(s, r, num_vars, 2, clauses);
+
+    bool expected = false;
+    for (unsigned a = 0; !expected && a < (1u << num_vars); ++a)
+        expected = satisfies(a, clauses);
+
+    lbool is_sat = s.check();
+    ENSURE(is_sat == (expected ? l_true : l_false));
+    if (is_sat == l_true)
+        ENSURE(satisfied(s.get_model(), clauses));
+    return is_sat;
+}
+
+void tst_sat_propagate() {
+    for (unsigned seed = 0; seed < 10; ++seed)
+        tst_push_binary_watch(seed);
+    unsigned num_sat = 0, num_unsat = 0;
+    for (unsigned seed = 0; seed < 40; ++seed) {
+        if (tst_random_instance(seed, 14, 6 + seed % 16, 30 + 4 * (seed % 10)) == l_true)
+            ++num_sat;
+        else
+            ++num_unsat;
+    }
+    ENSURE(num_sat > 0 && num_unsat > 0);
+}
+
+static void bench_propagate(unsigned seed, unsigned num_vars) {
+    params_ref p;
+    reslimit rlim;
+    sat::solver s(p, rlim);
+    random_gen r(seed);
+    vector<sat::literal_vector> clauses;
+    for (unsigned i = 0; i < num_vars; ++i)
+        s.mk_var();
+    for (unsigned i = 0; i < num_vars / 2; ++i)
+        add_random_clause(s, r, num_vars, 2, clauses);
+    for (unsigned i = 0; i < 4 * num_vars; ++i)
+        add_random_clause(s, r, num_vars, 4, clauses);
+
+    stopwatch sw;
+    sw.start();
+    lbool is_sat = s.check();
+    sw.stop();
+    statistics st;
+    s.collect_statistics(st);
+    std::cout << "vars: " << num_vars << " result: " << is_sat << " time: " << sw.get_seconds() << "s\n";
+    st.display(std::cout);
+    if (is_sat == l_true)
+        ENSURE(satisfied(s.get_model(), clauses));
+}
+
+// usage: sat_propagate_bench [num_vars]
+void tst_sat_propagate_bench(char** argv, int argc, int& i) {
+    unsigned num_vars = 20000;
+    if (i + 1 < argc) {
+        num_vars = atoi(argv[i + 1]);
+        ++i;
+    }
+    bench_propagate(0, 1000);
+    bench_propagate(1, num_vars);
+}
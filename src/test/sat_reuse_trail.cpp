@@ -0,0 +1,95 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    sat_reuse_trail.cpp
+
+Abstract:
+
+    Incremental checks with growing and changing assumptions.
+    Results are compared against a fresh solver for each check.
+
+--*/
+
+#include <iostream>
+#include "sat/sat_solver.h"
+#include "util/statistics.h"
+#include "util/util.h"
+
+static void add_clauses(sat::solver& s, vector<sat::literal_vector> const& clauses, unsigned num_vars) {
+    for (unsigned i = 0; i < num_vars; ++i)
+        s.mk_var();
+    for (auto const& cls : clauses)
+        s.mk_clause(cls.size(), cls.data());
+}
+
+static void check_model(sat::solver& s, vector<sat::literal_vector> const& clauses, sat::literal_vector const& asms) {
+    sat::model const& m = s.get_model();
+    for (auto const& cls : clauses) {
+        bool found = false;
+        for (sat::literal lit : cls)
+            found |= value_at(lit, m) == l_true;
+        ENSURE(found);
+    }
+    for (sat::literal lit : asms)
+        ENSURE(value_at(lit, m) == l_true);
+}
+
+static void tst_reuse_trail(unsigned seed, unsigned num_vars, unsigned num_checks) {
+    random_gen r(seed);
+    vector<sat::literal_vector> clauses;
+    for (unsigned i = 0; i < 4 * num_vars; ++i) {
+        sat::literal_vector cls;
+        while (cls.size() < 3) {
+            sat::literal lit(r(num_vars), r(2) == 0);
+            if (!cls.contains(lit) && !cls.contains(~lit))
+                cls.push_back(lit);
+        }
+        clauses.push_back(cls);
+    }
+
+    params_ref p;
+    reslimit rlim;
+    sat::solver s(p, rlim);
+    add_clauses(s, clauses, num_vars);
+
+    sat::literal_vector asms;
+    unsigned num_sat = 0, num_unsat = 0;
+    for (unsigned i = 0; i < num_checks; ++i) {
+        // mostly extend the assumptions, sometimes replace the last ones.
+        if (!asms.empty() && r(3) == 0)
+            asms.shrink(r(asms.size()));
+        sat::literal lit(r(num_vars), r(2) == 0);
+        if (!asms.contains(lit) && !asms.contains(~lit))
+            asms.push_back(lit);
+
+        lbool is_sat1 = s.check(asms.size(), asms.data());
+
+        reslimit rlim2;
+        sat::solver s2(p, rlim2);
+        add_clauses(s2, clauses, num_vars);
+        lbool is_sat2 = s2.check(asms.size(), asms.data());
+        ENSURE(is_sat1 == is_sat2);
+
+        if (is_sat1 == l_true) {
+            ++num_sat;
+            check_model(s, clauses, asms);
+        }
+        else if (is_sat1 == l_false) {
+            ++num_unsat;
+            for (sat::literal c : s.get_core())
+                ENSURE(asms.contains(c));
+            asms.reset();
+        }
+    }
+    statistics st;
+    s.collect_statistics(st);
+    std::cout << "vars: " << num_vars << " sat: " << num_sat << " unsat: " << num_unsat << "\n";
+    st.display(std::cout);
+}
+
+void tst_sat_reuse_trail() {
+    tst_reuse_trail(0, 50, 200);
+    tst_reuse_trail(1, 200, 200);
+}
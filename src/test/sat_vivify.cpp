@@ -0,0 +1,146 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    sat_vivify.cpp
+
+Abstract:
+
+    Test clause vivification (sat.vivify) in asymmetric branching:
+    clauses are shortened when propagating the negation of a prefix
+    produces a true literal or makes literals false, and the
+    shortened clauses preserve satisfiability.
+
+--*/
+
+#include <cstring>
+#include <cstdlib>
+#include "sat/sat_solver.h"
+#include "sat/sat_asymm_branch.h"
+#include "util/statistics.h"
+#include "util/util.h"
+
+static params_ref vivify_params(bool vivify) {
+    params_ref p;
+    p.set_bool("asymm_branch", false);
+    p.set_bool("asymm_branch.sampled", false);
+    p.set_uint("asymm_branch.delay", 0);
+    p.set_bool("vivify", vivify);
+    return p;
+}
+
+static unsigned get_stat(statistics const& st, char const* key) {
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (st.is_uint(i) && 0 == strcmp(st.get_key(i), key))
+            return st.get_uint_value(i);
+    return 0;
+}
+
+static sat::literal_vector mk_lits(std::initializer_list<int> lits) {
+    sat::literal_vector r;
+    for (int l : lits)
+        r.push_back(sat::literal(std::abs(l) - 1, l < 0));
+    return r;
+}
+
+static bool has_clause(sat::solver const& s, sat::literal_vector const& lits) {
+    for (sat::clause* c : s.clauses()) {
+        if (c->size() != lits.size())
+            continue;
+        bool found = true;
+        for (sat::literal l : lits)
+            found &= c->contains(l);
+        if (found)
+            return true;
+    }
+    return false;
+}
+
+static void tst_shorten(bool vivify) {
+    params_ref p = vivify_params(vivify);
+    reslimit rlim;
+    sat::solver s(p, rlim);
+    for (unsigned i = 0; i < 11; ++i)
+        s.mk_var();
+    vector<sat::literal_vector> clauses;
+    // not 1, not 2 propagate 3, so the first clause becomes 1 2 3.
+    clauses.push_back(mk_lits({1, 2, 3, 4, 5, 6}));
+    clauses.push_back(mk_lits({1, 2, 3}));
+    // not 7 propagates not 9, so 9 is removed from the third clause.
+    clauses.push_back(mk_lits({7, 8, 9, 10}));
+    clauses.push_back(mk_lits({7, -9}));
+    // nothing to shorten.
+    clauses.push_back(mk_lits({-1, -4, 11}));
+    for (auto const& cls : clauses)
+        s.mk_clause(cls.size(), cls.data());
+
+    sat::asymm_branch ab(s, p);
+    ab(true);
+    statistics st;
+    ab.collect_statistics(st);
+    if (vivify) {
+        ENSURE(get_stat(st, "sat vivified clauses") == 2);
+        ENSURE(get_stat(st, "sat elim literals") == 4);
+        ENSURE(!has_clause(s, clauses[0]));
+        ENSURE(has_clause(s, mk_lits({1, 2, 3})));
+        ENSURE(!has_clause(s, clauses[2]));
+        ENSURE(has_clause(s, mk_lits({7, 8, 10})));
+    }
+    else {
+        ENSURE(get_stat(st, "sat vivified clauses") == 0);
+        ENSURE(has_clause(s, clauses[0]));
+        ENSURE(has_clause(s, clauses[2]));
+    }
+    ENSURE(has_clause(s, clauses[4]));
+    ENSURE(s.check() == l_true);
+    sat::model const& m = s.get_model();
+    for (auto const& cls : clauses) {
+        bool found = false;
+        for (sat::literal lit : cls)
+            found |= value_at(lit, m) == l_true;
+        ENSURE(found);
+    }
+}
+
+// vivified random instances are equisatisfiable with the originals.
+static void tst_random(unsigned seed) {
+    random_gen r(seed);
+    unsigned num_vars = 30;
+    vector<sat::literal_vector> clauses;
+    for (unsigned i = 0; i < 130; ++i) {
+        sat::literal_vector cls;
+        unsigned sz = 2 + r(4);
+        while (cls.size() < sz) {
+            sat::literal lit(r(num_vars), r(2) == 0);
+            if (!cls.contains(lit) && !cls.contains(~lit))
+                cls.push_back(lit);
+        }
+        clauses.push_back(cls);
+    }
+    lbool expected = l_undef;
+    for (bool vivify : { false, true }) {
+        params_ref p = vivify_params(vivify);
+        reslimit rlim;
+        sat::solver s(p, rlim);
+        for (unsigned i = 0; i < num_vars; ++i)
+            s.mk_var();
+        for (auto const& cls : clauses)
+            s.mk_clause(cls.size(), cls.data());
+        sat::asymm_branch ab(s, p);
+        if (!s.inconsistent())
+            ab(true);
+        lbool is_sat = s.check();
+        ENSURE(is_sat != l_undef);
+        if (expected == l_undef)
+            expected = is_sat;
+        ENSURE(is_sat == expected);
+    }
+}
+
+void tst_sat_vivify() {
+    tst_shorten(false);
+    tst_shorten(true);
+    for (unsigned seed = 0; seed < 20; ++seed)
+        tst_random(seed);
+}
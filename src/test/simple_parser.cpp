@@ -60,5 +60,23 @@ void tst_simple_parser() {
     TRACE("simple_parser", 
           tout << mk_pp(r, m) << "\n";
           tout << "val: " << eval(r, 2, vals) << "\n";);
+
+    // compiled cost functions agree with the evaluator.
+    char const * fns[] = {
+        "x", "3", "(+ x y)", "(+ x (* 10 y) 2)", "(- (/ x y) 2)", "(ite (and (> x 3) (<= y 4)) 2 10)",
+        "(ite (or (> x 3) (<= y 4) (= x y)) 2 10)", "(ite (implies (< x y) (not (= x 2))) x y)",
+        "(ite (xor (>= x y) true) (ite false 1 x) (ite (and true (> x 1)) y 2))"
+    };
+    compiled_cost_function cf(m);
+    for (char const * fn : fns) {
+        VERIFY(p.parse_string(fn, r));
+        cf.set(r);
+        for (float x = 0.0f; x < 6.0f; x += 1.0f) {
+            for (float y = 1.0f; y < 6.0f; y += 1.0f) {
+                float args[2] = { x, y };
+                ENSURE(cf(2, args) == eval(r, 2, args));
+            }
+        }
+    }
 }
 
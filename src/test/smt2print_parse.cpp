@@ -8,7 +8,15 @@ Copyright (c) 2015 Microsoft Corporation
 // for SMT-LIB2.
 
 #include "api/z3.h"
+#include "util/util.h"
+#include "util/timer.h"
 #include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 void test_print(Z3_context ctx, Z3_ast_vector av) {
     Z3_set_ast_print_mode(ctx, Z3_PRINT_SMTLIB2_COMPLIANT);
@@ -129,3 +137,59 @@ void tst_smt2print_parse() {
     // Test ?     
 
 }
+
+// Parse throughput when each thread parses files into its own context.
+// Usage: smt2_parse_threads [max_threads]
+static std::string mk_parse_bench_spec(unsigned file) {
+    std::string spec;
+    unsigned const num_consts = 2000;
+    for (unsigned i = 0; i < num_consts; ++i) 
+        spec += "(declare-const x_" + std::to_string(file) + "_" + std::to_string(i) + " Int)\n";
+    for (unsigned i = 0; i + 2 < num_consts; ++i) {
+        std::string x = "x_" + std::to_string(file) + "_";
+        spec += "(assert (or (< (+ " + x + std::to_string(i) + " " + x + std::to_string(i + 1) + ") 10) (= " + x + std::to_string(i + 2) + " 3)))\n";
+    }
+    return spec;
+}
+
+void tst_smt2_parse_threads(char** argv, int argc, int& i) {
+    unsigned max_threads = 8;
+    if (i + 1 < argc) {
+        max_threads = atoi(argv[i + 1]);
+        ++i;
+    }
+    unsigned const num_files = 16;
+    unsigned const num_rounds = 4;
+    std::vector<std::string> specs;
+    for (unsigned f = 0; f < num_files; ++f) 
+        specs.push_back(mk_parse_bench_spec(f));
+#ifdef SINGLE_THREAD
+    max_threads = 1;
+#endif
+    for (unsigned n = 1; n <= max_threads; n *= 2) {
+        auto parse = [&](unsigned k) {
+            for (unsigned r = 0; r < num_rounds; ++r) {
+                for (unsigned f = k; f < num_files; f += n) {
+                    Z3_context ctx = Z3_mk_context(nullptr);
+                    Z3_ast_vector a = Z3_parse_smtlib2_string(ctx, specs[f].c_str(), 0, nullptr, nullptr, 0, nullptr, nullptr);
+                    Z3_ast_vector_inc_ref(ctx, a);
+                    Z3_ast_vector_dec_ref(ctx, a);
+                    Z3_del_context(ctx);
+                }
+            }
+        };
+        timer t;
+#ifdef SINGLE_THREAD
+        parse(0);
+#else
+        std::vector<std::thread> threads;
+        for (unsigned k = 0; k < n; ++k) 
+            threads.push_back(std::thread(parse, k));
+        for (auto& th : threads) 
+            th.join();
+#endif
+        double secs = t.get_seconds();
+        std::cout << "threads: " << n << " files: " << num_files * num_rounds << " time: " << secs << "s"
+                  << " files/s: " << (secs > 0 ? num_files * num_rounds / secs : 0) << "\n";
+    }
+}
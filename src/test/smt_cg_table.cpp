@@ -0,0 +1,212 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    smt_cg_table.cpp
+
+Abstract:
+
+    Test the congruence table of the smt core: applications are found
+    modulo the roots of their arguments, and the keys of unary and binary
+    applications that are updated on reinsert after a merge agree with
+    the keys computed from the new roots.
+
+--*/
+
+#include <map>
+#include <tuple>
+#include "util/util.h"
+#include "smt/smt_cg_table.h"
+
+namespace {
+    class cg_table_tester {
+        ast_manager         m;
+        region              m_region;
+        smt::enode_vector   m_app2enode;
+        ast_ref_vector      m_pinned;
+        smt::enode_vector   m_consts;
+        smt::enode_vector   m_apps;
+        bool_vector         m_in_table;
+        smt::cg_table       m_table;
+        unsigned            m_num_comm { 0 };
+
+        smt::enode* mk(app* a) {
+            m_pinned.push_back(a);
+            m_app2enode.reserve(a->get_id() + 1, nullptr);
+            smt::enode* n = smt::enode::mk(m, m_region, m_app2enode, a, 0, false, false, 0, true, false);
+            m_app2enode[a->get_id()] = n;
+            return n;
+        }
+
+        typedef std::tuple<func_decl*, smt::enode*, smt::enode*, smt::enode*> signature;
+
+        static signature get_signature(smt::enode* n) {
+            smt::enode* args[3] = { nullptr, nullptr, nullptr };
+            for (unsigned i = 0; i < n->get_num_args(); ++i)
+                args[i] = n->get_arg(i)->get_root();
+            if (n->get_num_args() == 2 && n->get_decl()->is_commutative() && args[1]->get_owner_id() < args[0]->get_owner_id())
+                std::swap(args[0], args[1]);
+            return std::make_tuple(n->get_decl(), args[0], args[1], args[2]);
+        }
+
+    public:
+        cg_table_tester(): m_pinned(m), m_table(m) {}
+
+        ~cg_table_tester() {
+            m_table.reset();
+            for (smt::enode* n : m_consts)
+                n->set_root(n);
+            for (smt::enode* n : m_apps)
+                n->del_eh(m, false);
+            for (smt::enode* n : m_consts)
+                n->del_eh(m, false);
+        }
+
+        void mk_terms(unsigned seed, unsigned num_consts, unsigned num_apps) {
+            random_gen r(seed);
+            sort* S = m.mk_uninterpreted_sort(symbol("S"));
+            sort* dom[3] = { S, S, S };
+            func_decl_info info;
+            info.set_commutative();
+            func_decl* fs[4] = {
+                m.mk_func_decl(symbol("f"), 1, dom, S),
+                m.mk_func_decl(symbol("h"), 2, dom, S),
+                m.mk_func_decl(symbol("c"), 2, dom, S, info),
+                m.mk_func_decl(symbol("k"), 3, dom, S)
+            };
+            m_pinned.push_back(S);
+            for (func_decl* f : fs)
+                m_pinned.push_back(f);
+            for (unsigned i = 0; i < num_consts; ++i)
+                m_consts.push_back(mk(m.mk_const(symbol(i), S)));
+            for (unsigned i = 0; i < num_apps; ++i) {
+                func_decl* d = fs[r(4)];
+                expr* args[3];
+                for (unsigned j = 0; j < d->get_arity(); ++j)
+                    args[j] = m_consts[r(num_consts)]->get_expr();
+                m_apps.push_back(mk(m.mk_app(d, d->get_arity(), args)));
+                smt::enode_bool_pair p = m_table.insert(m_apps.back());
+                m_in_table.push_back(p.first == m_apps.back());
+            }
+        }
+
+        /**
+           \brief Merge the class of r1 into r2 in the way smt::context does:
+           erase the applications over r1, update the roots and reinsert the
+           applications with their old keys.
+        */
+        void merge(smt::enode* r1, smt::enode* r2) {
+            SASSERT(r1->is_root() && r2->is_root() && r1 != r2);
+            unsigned_vector parents;
+            svector<uint64_t> keys;
+            for (unsigned i = 0; i < m_apps.size(); ++i) {
+                if (!m_in_table[i])
+                    continue;
+                smt::enode* n = m_apps[i];
+                bool is_parent = false;
+                for (unsigned j = 0; j < n->get_num_args(); ++j)
+                    is_parent |= n->get_arg(j)->get_root() == r1;
+                if (!is_parent)
+                    continue;
+                ENSURE(m_table.contains_ptr(n));
+                parents.push_back(i);
+                keys.push_back(m_table.erase(n));
+                ENSURE(!m_table.contains_ptr(n));
+            }
+            for (smt::enode* n : m_consts)
+                if (n->get_root() == r1)
+                    n->set_root(r2);
+            for (unsigned k = 0; k < parents.size(); ++k) {
+                smt::enode* n = m_apps[parents[k]];
+                smt::enode_bool_pair p = m_table.reinsert(n, keys[k], r1, r2);
+                if (p.first == n)
+                    continue;
+                m_in_table[parents[k]] = false;
+                ENSURE(get_signature(p.first) == get_signature(n));
+                if (p.second)
+                    ++m_num_comm;
+                ENSURE(p.second == (p.first->get_arg(0)->get_root() != n->get_arg(0)->get_root()));
+            }
+        }
+
+        void merge_random(random_gen& r) {
+            smt::enode* r1 = m_consts[r(m_consts.size())]->get_root();
+            smt::enode* r2 = m_consts[r(m_consts.size())]->get_root();
+            if (r1 != r2)
+                merge(r1, r2);
+        }
+
+        /**
+           \brief Every application is congruent to the application the
+           table returns for it, and applications in the table have
+           distinct signatures.
+        */
+        void check() {
+            std::map<signature, smt::enode*> sigs;
+            for (unsigned i = 0; i < m_apps.size(); ++i) {
+                smt::enode* n = m_apps[i];
+                smt::enode* n_prime = m_table.find(n);
+                ENSURE(n_prime);
+                ENSURE(get_signature(n_prime) == get_signature(n));
+                ENSURE(m_table.contains(n));
+                ENSURE(m_in_table[i] == m_table.contains_ptr(n));
+                if (m_in_table[i])
+                    ENSURE(sigs.emplace(get_signature(n), n).second);
+            }
+        }
+
+        smt::enode* get_const(unsigned i) const { return m_consts[i]; }
+        bool in_table(unsigned i) const { return m_in_table[i]; }
+        unsigned num_comm() const { return m_num_comm; }
+
+        smt::enode* mk_app(char const* name, smt::enode* a, smt::enode* b, bool comm) {
+            sort* S = a->get_sort();
+            sort* dom[2] = { S, S };
+            func_decl_info info;
+            if (comm)
+                info.set_commutative();
+            func_decl* d = m.mk_func_decl(symbol(name), 2, dom, S, info);
+            m_apps.push_back(mk(m.mk_app(d, a->get_expr(), b->get_expr())));
+            smt::enode_bool_pair p = m_table.insert(m_apps.back());
+            m_in_table.push_back(p.first == m_apps.back());
+            return m_apps.back();
+        }
+    };
+}
+
+// c(x0, x1) and c(x2, x0) become congruent modulo commutativity when x2 is merged into x1.
+static void tst_commutativity() {
+    cg_table_tester t;
+    t.mk_terms(0, 3, 0);
+    smt::enode* x0 = t.get_const(0), *x1 = t.get_const(1), *x2 = t.get_const(2);
+    t.mk_app("c", x0, x1, true);
+    t.mk_app("c", x2, x0, true);
+    t.mk_app("h", x0, x1, false);
+    t.mk_app("h", x2, x0, false);
+    t.check();
+    t.merge(x2, x1);
+    t.check();
+    ENSURE(t.in_table(0) && !t.in_table(1));
+    ENSURE(t.in_table(2) && t.in_table(3));
+    ENSURE(t.num_comm() == 1);
+}
+
+static void tst_random(unsigned seed, unsigned num_consts, unsigned num_apps) {
+    cg_table_tester t;
+    t.mk_terms(seed, num_consts, num_apps);
+    t.check();
+    random_gen r(seed);
+    for (unsigned i = 0; i < num_consts; ++i) {
+        t.merge_random(r);
+        if (i % 8 == 0)
+            t.check();
+    }
+    t.check();
+}
+
+void tst_smt_cg_table() {
+    tst_commutativity();
+    for (unsigned seed = 0; seed < 10; ++seed)
+        tst_random(seed, 20 + 10 * seed, 200);
+}
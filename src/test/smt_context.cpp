@@ -4,8 +4,13 @@ Copyright (c) 2015 Microsoft Corporation
 
 --*/
 
+#include <cstdlib>
+#include <cstring>
 #include "smt/smt_context.h"
 #include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "util/timer.h"
+#include "util/statistics.h"
 
 void tst_smt_context()
 {
@@ -35,3 +40,233 @@ void tst_smt_context()
 
     ctx.check();
 }
+
+/**
+   Assert random ground clauses over equalities between constants
+   and unary and binary applications.
+*/
+static void assert_uf_clauses(smt::context& ctx, unsigned seed, unsigned num_consts, unsigned num_clauses) {
+    ast_manager& m = ctx.get_manager();
+    random_gen r(seed);
+    sort_ref S(m.mk_uninterpreted_sort(symbol("S")), m);
+    sort* dom[2] = { S.get(), S.get() };
+    func_decl_ref f(m.mk_func_decl(symbol("f"), 1, dom, S), m);
+    func_decl_ref g(m.mk_func_decl(symbol("g"), 2, dom, S), m);
+    expr_ref_vector terms(m);
+    for (unsigned i = 0; i < num_consts; ++i)
+        terms.push_back(m.mk_const(symbol(i), S));
+    for (unsigned i = 0; i < num_consts; ++i) {
+        terms.push_back(m.mk_app(f, terms.get(r(terms.size()))));
+        terms.push_back(m.mk_app(g, terms.get(r(terms.size())), terms.get(r(terms.size()))));
+    }
+    for (unsigned i = 0; i < num_clauses; ++i) {
+        expr_ref_vector lits(m);
+        for (unsigned j = 0; j < 3; ++j) {
+            expr_ref eq(m.mk_eq(terms.get(r(terms.size())), terms.get(r(terms.size()))), m);
+            lits.push_back(r(2) == 0 ? eq : expr_ref(m.mk_not(eq), m));
+        }
+        ctx.assert_expr(m.mk_or(lits));
+    }
+}
+
+/**
+   Assert random propositional clauses, where some literals are
+   conjunctions. Boolean constants are not propagated to the egraph
+   or to theories, so their relevancy is not demanded before final check.
+*/
+static void assert_bool_clauses(smt::context& ctx, unsigned seed, unsigned num_vars, unsigned num_clauses) {
+    ast_manager& m = ctx.get_manager();
+    random_gen r(seed);
+    expr_ref_vector vars(m);
+    for (unsigned i = 0; i < num_vars; ++i)
+        vars.push_back(m.mk_const(symbol(i), m.mk_bool_sort()));
+    auto mk_lit = [&]() {
+        expr_ref v(vars.get(r(num_vars)), m);
+        return r(2) == 0 ? v : expr_ref(m.mk_not(v), m);
+    };
+    for (unsigned i = 0; i < num_clauses; ++i) {
+        expr_ref_vector lits(m);
+        lits.push_back(mk_lit());
+        lits.push_back(mk_lit());
+        if (r(4) == 0)
+            lits.push_back(m.mk_and(mk_lit(), mk_lit()));
+        else
+            lits.push_back(mk_lit());
+        ctx.assert_expr(m.mk_or(lits));
+    }
+}
+
+static unsigned get_uint_statistic(smt::context& ctx, char const* key) {
+    statistics st;
+    ctx.collect_statistics(st);
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0)
+            return st.get_uint_value(i);
+    // statistics that are zero are not reported.
+    return 0;
+}
+
+static lbool check_relevancy(unsigned seed, bool uf, bool lazy, unsigned& num_conflicts, unsigned& num_skipped) {
+    smt_params params;
+    params.m_relevancy_lazy = lazy;
+    ast_manager m;
+    reg_decl_plugins(m);
+    smt::context ctx(m, params);
+    if (uf)
+        assert_uf_clauses(ctx, seed, 8, 160 + 15 * seed);
+    else
+        assert_bool_clauses(ctx, seed, 60, 240 + 2 * seed);
+    lbool is_sat = ctx.check();
+    num_conflicts = get_uint_statistic(ctx, "conflicts");
+    num_skipped = get_uint_statistic(ctx, "relevancy skipped lits");
+    // only lazy relevancy propagation skips assignments undone by conflicts.
+    if (!lazy)
+        ENSURE(num_skipped == 0);
+    return is_sat;
+}
+
+/**
+   Eager and lazy relevancy propagation agree on random ground
+   clauses that require conflicts and backtracking. On propositional
+   clauses, lazy propagation skips assignments that are undone before
+   final check.
+*/
+void tst_smt_context_relevancy() {
+    for (bool uf : { true, false }) {
+        unsigned num_sat = 0, num_unsat = 0, sat_conflicts = 0, num_skipped = 0;
+        for (unsigned seed = 0; seed < 16; ++seed) {
+            unsigned c1 = 0, c2 = 0, s1 = 0, s2 = 0;
+            lbool r1 = check_relevancy(seed, uf, false, c1, s1);
+            lbool r2 = check_relevancy(seed, uf, true, c2, s2);
+            ENSURE(r1 == r2);
+            num_skipped += s2;
+            if (r1 == l_true) {
+                ++num_sat;
+                sat_conflicts += std::min(c1, c2);
+            }
+            else {
+                ENSURE(r1 == l_false);
+                ++num_unsat;
+            }
+        }
+        // satisfiable instances are found after backtracking and the others are refuted.
+        ENSURE(num_sat > 0 && num_unsat > 0 && sat_conflicts > 0);
+        if (!uf)
+            ENSURE(num_skipped > 0);
+    }
+}
+
+/**
+   Congruence closure benchmark on random ground clauses over
+   equalities between unary and binary applications.
+   Reports the memory used by enodes and the solving time.
+*/
+static void bench_enodes(unsigned seed, unsigned num_consts, unsigned num_clauses) {
+    smt_params params;
+    ast_manager m;
+    reg_decl_plugins(m);
+    smt::context ctx(m, params);
+    assert_uf_clauses(ctx, seed, num_consts, num_clauses);
+    timer t;
+    lbool is_sat = ctx.check();
+    double secs = t.get_seconds();
+    size_t bytes = 0;
+    for (smt::enode* n : ctx.enodes())
+        bytes += smt::enode::get_enode_size(n->get_num_args());
+    statistics st;
+    ctx.collect_statistics(st);
+    std::cout << "consts: " << num_consts << " clauses: " << num_clauses
+              << " result: " << is_sat << " sizeof(enode): " << sizeof(smt::enode)
+              << " enodes: " << ctx.enodes().size() << " enode bytes: " << bytes
+              << " time: " << secs << "s\n";
+    st.display(std::cout);
+}
+
+void tst_smt_context_enodes(char** argv, int argc, int& i) {
+    unsigned num_consts = 20000;
+    if (i + 1 < argc)
+        num_consts = atoi(argv[++i]);
+    bench_enodes(3, num_consts, 2 * num_consts);
+}
+
+/**
+   Random QF_LRA problems solved with and without the double precision
+   presolve of the simplex tableau. If unsat is set, the sum of some of
+   the inequalities is asserted to exceed the sum of their bounds.
+   Some bounds are negative, so the first solve starts from an infeasible
+   basis and the presolve runs.
+*/
+static lbool solve_lra(unsigned seed, unsigned num_vars, unsigned num_ineqs, params_ref const& p, bool unsat, bool verbose) {
+    smt_params fparams;
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    smt::context ctx(m, fparams, p);
+    random_gen r(seed);
+    expr_ref_vector xs(m), lhs(m);
+    int rhs = 0;
+    for (unsigned i = 0; i < num_vars; ++i)
+        xs.push_back(m.mk_const(symbol(i), a.mk_real()));
+    for (unsigned i = 0; i < num_ineqs; ++i) {
+        expr_ref_vector sum(m);
+        for (unsigned j = 0; j < 4; ++j) {
+            int c = static_cast<int>(r(21)) - 10;
+            sum.push_back(a.mk_mul(a.mk_real(c), xs.get(r(num_vars))));
+        }
+        int bound = static_cast<int>(r(100)) - 30;
+        expr_ref ineq(a.mk_le(a.mk_add(sum.size(), sum.data()), a.mk_real(bound)), m);
+        // add some disjunctions to make the solver backtrack
+        if (r(4) == 0)
+            ineq = m.mk_or(ineq, a.mk_ge(xs.get(r(num_vars)), a.mk_real(static_cast<int>(r(50)))));
+        else if (unsat && lhs.size() < 3) {
+            lhs.append(sum);
+            rhs += bound;
+        }
+        ctx.assert_expr(ineq);
+    }
+    if (unsat)
+        ctx.assert_expr(a.mk_ge(a.mk_add(lhs.size(), lhs.data()), a.mk_real(rhs + 1)));
+    timer t;
+    lbool is_sat = ctx.check();
+    double secs = t.get_seconds();
+    if (verbose) {
+        statistics st;
+        ctx.collect_statistics(st);
+        std::cout << "vars: " << num_vars << " ineqs: " << num_ineqs << " params: " << p
+                  << " result: " << is_sat << " time: " << secs << "s\n";
+        st.display(std::cout);
+    }
+    return is_sat;
+}
+
+void tst_smt_context_lra() {
+    params_ref p0, p1, p2;
+    p1.set_bool("arith.presolve_with_doubles", true);
+    p2.set_uint("arith.bprop_max_rows", 8);
+    for (unsigned seed = 0; seed < 8; ++seed) {
+        bool unsat = seed % 2 == 1;
+        lbool r0 = solve_lra(seed, 100, 140, p0, unsat, false);
+        lbool r1 = solve_lra(seed, 100, 140, p1, unsat, false);
+        lbool r2 = solve_lra(seed, 100, 140, p2, unsat, false);
+        ENSURE(r0 == r1);
+        ENSURE(r0 == r2);
+        if (unsat)
+            ENSURE(r0 == l_false);
+    }
+}
+
+/**
+   Solving time on a larger instance, with and without the presolve.
+*/
+void tst_smt_context_lra_bench(char** argv, int argc, int& i) {
+    unsigned num_vars = 1000;
+    if (i + 1 < argc)
+        num_vars = atoi(argv[++i]);
+    unsigned num_ineqs = 7 * num_vars / 5;
+    params_ref p0, p1, p2;
+    p1.set_bool("arith.presolve_with_doubles", true);
+    p2.set_uint("arith.bprop_max_rows", 8);
+    solve_lra(4, num_vars, num_ineqs, p0, false, true);
+    solve_lra(4, num_vars, num_ineqs, p1, false, true);
+    solve_lra(4, num_vars, num_ineqs, p2, false, true);
+}
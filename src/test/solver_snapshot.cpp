@@ -0,0 +1,124 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    solver_snapshot.cpp
+
+Abstract:
+
+    Test snapshots of solvers: restore a solver to a snapshot and
+    fork a snapshot into several solvers that are checked independently.
+
+--*/
+
+#include "api/z3.h"
+#include "util/util.h"
+#include "util/debug.h"
+#include <string>
+
+namespace {
+    // integer or unsigned bit-vector variables x_i.
+    struct vars {
+        Z3_context m_ctx;
+        bool       m_bv;
+        Z3_sort    m_sort;
+        vars(Z3_context ctx, bool bv): m_ctx(ctx), m_bv(bv) {
+            m_sort = bv ? Z3_mk_bv_sort(ctx, 8) : Z3_mk_int_sort(ctx);
+        }
+        Z3_ast x(unsigned i) {
+            std::string name = "x" + std::to_string(i);
+            return Z3_mk_const(m_ctx, Z3_mk_string_symbol(m_ctx, name.c_str()), m_sort);
+        }
+        Z3_ast num(int v) { return Z3_mk_int(m_ctx, v, m_sort); }
+        Z3_ast lt(Z3_ast a, Z3_ast b) { return m_bv ? Z3_mk_bvult(m_ctx, a, b) : Z3_mk_lt(m_ctx, a, b); }
+        Z3_ast le(Z3_ast a, Z3_ast b) { return m_bv ? Z3_mk_bvule(m_ctx, a, b) : Z3_mk_le(m_ctx, a, b); }
+        int value(Z3_model mdl, Z3_ast t) {
+            Z3_ast v = nullptr;
+            ENSURE(Z3_model_eval(m_ctx, mdl, t, true, &v));
+            int r = 0;
+            ENSURE(Z3_get_numeral_int(m_ctx, v, &r));
+            return r;
+        }
+    };
+}
+
+/**
+   The prefix 0 <= x_0, x_i < x_(i+1) implies x_n >= n.
+   A query with x_n <= bound is satisfiable iff bound >= n.
+*/
+static void assert_prefix(vars& v, Z3_solver s, unsigned n) {
+    Z3_context ctx = v.m_ctx;
+    Z3_solver_assert(ctx, s, v.le(v.num(0), v.x(0)));
+    for (unsigned i = 0; i < n; ++i) 
+        Z3_solver_assert(ctx, s, v.lt(v.x(i), v.x(i + 1)));
+}
+
+static Z3_lbool check_query(vars& v, Z3_solver s, unsigned n, int bound) {
+    Z3_context ctx = v.m_ctx;
+    Z3_solver_assert(ctx, s, v.le(v.x(n), v.num(bound)));
+    Z3_lbool r = Z3_solver_check(ctx, s);
+    if (r == Z3_L_TRUE) {
+        Z3_model mdl = Z3_solver_get_model(ctx, s);
+        Z3_model_inc_ref(ctx, mdl);
+        ENSURE(v.value(mdl, v.x(0)) >= 0);
+        ENSURE(v.value(mdl, v.x(n)) <= bound);
+        Z3_model_dec_ref(ctx, mdl);
+    }
+    return r;
+}
+
+static void tst_snapshot(Z3_context ctx, Z3_solver s, bool bv) {
+    unsigned const n = 30;
+    vars v(ctx, bv);
+    Z3_solver_inc_ref(ctx, s);
+    assert_prefix(v, s, n);
+    ENSURE(Z3_solver_check(ctx, s) == Z3_L_TRUE);
+    unsigned num_prefix = Z3_ast_vector_size(ctx, Z3_solver_get_assertions(ctx, s));
+
+    Z3_solver snapshot = Z3_solver_snapshot(ctx, s);
+    Z3_solver_inc_ref(ctx, snapshot);
+
+    // the query makes s unsat, restoring the snapshot drops it again.
+    ENSURE(check_query(v, s, n, n - 1) == Z3_L_FALSE);
+    Z3_solver_restore(ctx, s, snapshot);
+    ENSURE(Z3_ast_vector_size(ctx, Z3_solver_get_assertions(ctx, s)) == num_prefix);
+    ENSURE(check_query(v, s, n, n) == Z3_L_TRUE);
+    Z3_solver_restore(ctx, s, snapshot);
+    ENSURE(check_query(v, s, n, n - 2) == Z3_L_FALSE);
+
+    // restoring discards the scopes of s.
+    Z3_solver_restore(ctx, s, snapshot);
+    Z3_solver_push(ctx, s);
+    ENSURE(check_query(v, s, n, 0) == Z3_L_FALSE);
+    Z3_solver_restore(ctx, s, snapshot);
+    ENSURE(Z3_solver_get_num_scopes(ctx, s) == 0);
+    ENSURE(Z3_solver_check(ctx, s) == Z3_L_TRUE);
+
+    // fork the snapshot into children that answer different queries.
+    for (int k = 0; k < 4; ++k) {
+        Z3_solver child = Z3_solver_snapshot(ctx, snapshot);
+        Z3_solver_inc_ref(ctx, child);
+        int bound = n - 2 + k;
+        ENSURE(check_query(v, child, n, bound) == (bound >= static_cast<int>(n) ? Z3_L_TRUE : Z3_L_FALSE));
+        Z3_solver_dec_ref(ctx, child);
+    }
+
+    // the snapshot itself was not changed by its children.
+    ENSURE(Z3_ast_vector_size(ctx, Z3_solver_get_assertions(ctx, snapshot)) == num_prefix);
+    ENSURE(Z3_solver_check(ctx, snapshot) == Z3_L_TRUE);
+
+    Z3_solver_dec_ref(ctx, snapshot);
+    Z3_solver_dec_ref(ctx, s);
+}
+
+void tst_solver_snapshot() {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_del_config(cfg);
+    tst_snapshot(ctx, Z3_mk_simple_solver(ctx), false);
+    tst_snapshot(ctx, Z3_mk_solver(ctx), false);
+    // a SAT based solver for bit-vectors.
+    tst_snapshot(ctx, Z3_mk_solver_for_logic(ctx, Z3_mk_string_symbol(ctx, "QF_FD")), true);
+    Z3_del_context(ctx);
+}
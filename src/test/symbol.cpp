@@ -19,6 +19,11 @@ Revision History:
 #include<iostream>
 #include "util/symbol.h"
 #include "util/debug.h"
+#include "util/vector.h"
+#include "util/string_buffer.h"
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 static void tst1() {
     symbol s1("foo");
@@ -51,8 +56,59 @@ static void tst1() {
     ENSURE(lt(symbol("zzz"), symbol("zzzb")));
 }
 
+#ifndef SINGLE_THREAD
+// intern overlapping pools of names from several threads, where new names are
+// created concurrently, and check that equal names are interned only once.
+static void tst_threads(unsigned num_threads) {
+    unsigned const num_shared = 3000;
+    unsigned const num_own = 500;
+    vector<std::string> names;
+    for (unsigned i = 0; i < num_shared + num_threads * num_own; ++i) {
+        string_buffer<> b;
+        b << "tst_symbol_" << num_threads << "_" << i;
+        names.push_back(b.c_str());
+    }
+    vector<svector<char const*>> results(num_threads);
+    vector<std::thread> threads(num_threads);
+    for (unsigned t = 0; t < num_threads; ++t) {
+        threads[t] = std::thread([&, t]() {
+            svector<char const*>& r = results[t];
+            r.resize(names.size(), nullptr);
+            // the shared names are visited in a different order by each thread.
+            for (unsigned k = 0; k < 2 * num_shared; ++k) {
+                unsigned i = (k * (2 * t + 1) + t * 97) % num_shared;
+                char const* s = symbol(names[i].c_str()).bare_str();
+                ENSURE(!r[i] || r[i] == s);
+                r[i] = s;
+            }
+            for (unsigned i = num_shared + t * num_own; i < num_shared + (t + 1) * num_own; ++i) {
+                r[i] = symbol(names[i].c_str()).bare_str();
+                ENSURE(symbol(names[i].c_str()).bare_str() == r[i]);
+            }
+        });
+    }
+    for (auto& th : threads) 
+        th.join();
+    for (unsigned t = 0; t < num_threads; ++t) {
+        for (unsigned i = 0; i < names.size(); ++i) {
+            char const* s = results[t][i];
+            if (!s)
+                continue;
+            ENSURE(names[i] == s);
+            ENSURE(symbol(names[i].c_str()).bare_str() == s);
+            if (i < num_shared)
+                ENSURE(s == results[0][i]);
+        }
+    }
+}
+#endif
+
 void tst_symbol() {
     tst1();
+#ifndef SINGLE_THREAD
+    for (unsigned n = 2; n <= 8; n *= 2) 
+        tst_threads(n);
+#endif
 }
 
 
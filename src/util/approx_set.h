@@ -66,7 +66,7 @@ public:
             insert(es[i]);
     }
 
-    approx_set_tpl(approx_set_tpl const & s):
+    approx_set_tpl(approx_set_tpl const & s) noexcept:
         m_set(s.m_set) {
     }
 
@@ -0,0 +1,172 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    async_ofstream.cpp
+
+Abstract:
+
+    Output file stream that writes in the background.
+
+--*/
+#include "util/async_ofstream.h"
+
+async_filebuf::async_filebuf(char const* file_name, std::ios_base::openmode mode, unsigned block_size):
+    m_out(file_name, mode | std::ios_base::out),
+    m_block_size(block_size),
+    m_failed(!m_out.is_open()),
+    m_closed(false)
+#ifndef SINGLE_THREAD
+    , m_max_pending(4),
+    m_num_writing(0),
+    m_closing(false)
+#endif
+{
+    reset_block();
+#ifndef SINGLE_THREAD
+    m_writer = std::thread([this]() { writer_loop(); });
+#endif
+}
+
+async_filebuf::~async_filebuf() {
+    close();
+}
+
+bool async_filebuf::close() {
+    if (m_closed)
+        return !m_failed;
+    sync();
+#ifndef SINGLE_THREAD
+    {
+        std::lock_guard<std::mutex> lock(m_mux);
+        m_closing = true;
+    }
+    m_cond.notify_all();
+    m_writer.join();
+#endif
+    m_closed = true;
+    setp(nullptr, nullptr);
+    if (m_out.is_open()) {
+        m_out.close();
+        if (m_out.fail())
+            m_failed = true;
+    }
+    return !m_failed;
+}
+
+bool async_filebuf::failed() {
+#ifndef SINGLE_THREAD
+    std::lock_guard<std::mutex> lock(m_mux);
+#endif
+    return m_failed;
+}
+
+void async_filebuf::reset_block() {
+    m_block.resize(m_block_size);
+    setp(m_block.data(), m_block.data() + m_block_size);
+}
+
+void async_filebuf::hand_off() {
+    unsigned n = static_cast<unsigned>(pptr() - pbase());
+    if (n == 0)
+        return;
+    m_block.shrink(n);
+#ifdef SINGLE_THREAD
+    m_out.write(m_block.data(), n);
+    if (!m_out)
+        m_failed = true;
+#else
+    {
+        std::unique_lock<std::mutex> lock(m_mux);
+        m_cond.wait(lock, [&]() { return m_pending.size() + m_num_writing < m_max_pending; });
+        m_pending.push_back(std::move(m_block));
+        m_block.reset();
+        if (!m_free.empty()) {
+            m_block = std::move(m_free.back());
+            m_free.pop_back();
+        }
+    }
+    m_cond.notify_all();
+#endif
+    reset_block();
+}
+
+void async_filebuf::wait_written() {
+#ifndef SINGLE_THREAD
+    std::unique_lock<std::mutex> lock(m_mux);
+    m_cond.wait(lock, [&]() { return m_pending.empty() && m_num_writing == 0; });
+#endif
+}
+
+#ifndef SINGLE_THREAD
+void async_filebuf::writer_loop() {
+    vector<svector<char>> blocks;
+    std::unique_lock<std::mutex> lock(m_mux);
+    while (true) {
+        m_cond.wait(lock, [&]() { return !m_pending.empty() || m_closing; });
+        if (m_pending.empty())
+            break;
+        blocks.swap(m_pending);
+        m_num_writing = blocks.size();
+        lock.unlock();
+        for (svector<char> const& b : blocks)
+            m_out.write(b.data(), b.size());
+        bool ok = !m_out.fail();
+        lock.lock();
+        if (!ok)
+            m_failed = true;
+        for (svector<char>& b : blocks) {
+            if (m_free.size() < m_max_pending) {
+                b.reset();
+                m_free.push_back(std::move(b));
+            }
+        }
+        blocks.reset();
+        m_num_writing = 0;
+        m_cond.notify_all();
+    }
+}
+#endif
+
+async_filebuf::int_type async_filebuf::overflow(int_type ch) {
+    if (m_closed)
+        return traits_type::eof();
+    hand_off();
+    if (failed())
+        return traits_type::eof();
+    if (traits_type::eq_int_type(ch, traits_type::eof()))
+        return traits_type::not_eof(ch);
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+    return ch;
+}
+
+int async_filebuf::sync() {
+    if (m_closed)
+        return m_failed ? -1 : 0;
+    hand_off();
+    wait_written();
+    // the writer is idle, so the file can be accessed here.
+    m_out.flush();
+    if (m_out.fail()) {
+#ifndef SINGLE_THREAD
+        std::lock_guard<std::mutex> lock(m_mux);
+#endif
+        m_failed = true;
+    }
+    return failed() ? -1 : 0;
+}
+
+async_ofstream::async_ofstream(char const* file_name, std::ios_base::openmode mode, unsigned block_size):
+    std::ostream(nullptr),
+    m_buf(file_name, mode, block_size) {
+    rdbuf(&m_buf);
+    if (!m_buf.is_open())
+        setstate(std::ios_base::failbit);
+}
+
+void async_ofstream::close() {
+    if (!m_buf.close())
+        setstate(std::ios_base::failbit);
+}
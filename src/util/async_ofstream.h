@@ -0,0 +1,77 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    async_ofstream.h
+
+Abstract:
+
+    Output file stream that writes in the background.
+
+    Output is collected in large blocks. Full blocks are handed to a
+    writer thread, so the producer only pays for copying into memory.
+    The producer waits when too many blocks are pending.
+    Flushing the stream waits until all pending blocks are written.
+    In single threaded builds blocks are written directly.
+    Errors of the writer are reported to the producer: once a write
+    failed, flushing, closing and further output set the stream state
+    to failed.
+
+--*/
+#pragma once
+
+#include <ostream>
+#include <fstream>
+#include "util/vector.h"
+#ifndef SINGLE_THREAD
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+class async_filebuf : public std::streambuf {
+    std::ofstream           m_out;
+    unsigned                m_block_size;
+    svector<char>           m_block;        // block being filled
+    bool                    m_failed;       // opening or writing the file failed
+    bool                    m_closed;
+#ifndef SINGLE_THREAD
+    unsigned                m_max_pending;
+    vector<svector<char>>   m_pending;      // full blocks, in order
+    unsigned                m_num_writing;  // blocks taken by the writer
+    vector<svector<char>>   m_free;         // blocks available for reuse
+    bool                    m_closing;
+    std::mutex              m_mux;
+    std::condition_variable m_cond;
+    std::thread             m_writer;
+    void writer_loop();
+#endif
+    void reset_block();
+    void hand_off();
+    void wait_written();
+    bool failed();
+protected:
+    int_type overflow(int_type ch) override;
+    int sync() override;
+public:
+    async_filebuf(char const* file_name, std::ios_base::openmode mode, unsigned block_size = 1 << 20);
+    ~async_filebuf() override;
+    bool is_open() const { return m_out.is_open(); }
+    /**
+       \brief write the remaining output, stop the writer and close the file.
+       Return false if the file could not be opened or written.
+    */
+    bool close();
+};
+
+class async_ofstream : public std::ostream {
+    async_filebuf m_buf;
+public:
+    async_ofstream(char const* file_name, std::ios_base::openmode mode = std::ios_base::out, unsigned block_size = 1 << 20);
+    bool is_open() const { return m_buf.is_open(); }
+    /**
+       \brief close the file and set the failbit if any output was lost.
+    */
+    void close();
+};
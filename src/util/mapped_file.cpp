@@ -0,0 +1,115 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    mapped_file.cpp
+
+Abstract:
+
+    Read-only view of a file's contents.
+
+--*/
+#include <fstream>
+#include "util/mapped_file.h"
+
+#ifdef _WINDOWS
+#include <windows.h>
+#elif defined(_LINUX_) || defined(__APPLE__) || defined(_FREEBSD_) || defined(_NetBSD_) || defined(_OPENBSD_) || defined(_CYGWIN) || defined(_HURD_)
+#define MAPPED_FILE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+mapped_file::mapped_file(char const* file_name, bool read_unmapped):
+    m_begin(nullptr),
+    m_end(nullptr),
+    m_open(false),
+    m_mapped(false) {
+#ifdef _WINDOWS
+    m_file = INVALID_HANDLE_VALUE;
+    m_mapping = nullptr;
+#endif
+    m_open = map(file_name) || (read_unmapped && read(file_name));
+}
+
+mapped_file::~mapped_file() {
+    if (!m_mapped)
+        return;
+#ifdef _WINDOWS
+    UnmapViewOfFile(m_begin);
+    CloseHandle(m_mapping);
+    CloseHandle(m_file);
+#elif defined(MAPPED_FILE_MMAP)
+    munmap(const_cast<char*>(m_begin), size());
+#endif
+}
+
+bool mapped_file::map(char const* file_name) {
+#ifdef _WINDOWS
+    HANDLE file = CreateFileA(file_name, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER sz;
+    if (!GetFileSizeEx(file, &sz) || sz.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void* p = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!p) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    m_file = file;
+    m_mapping = mapping;
+    m_begin = static_cast<char const*>(p);
+    m_end = m_begin + sz.QuadPart;
+    m_mapped = true;
+    return true;
+#elif defined(MAPPED_FILE_MMAP)
+    int fd = open(file_name, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    // empty files and special files (pipes, devices) are read instead.
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+        close(fd);
+        return false;
+    }
+    void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED)
+        return false;
+#ifdef MADV_SEQUENTIAL
+    madvise(p, st.st_size, MADV_SEQUENTIAL);
+#endif
+    m_begin = static_cast<char const*>(p);
+    m_end = m_begin + st.st_size;
+    m_mapped = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool mapped_file::read(char const* file_name) {
+    std::ifstream in(file_name, std::ios::in | std::ios::binary);
+    if (in.bad() || in.fail())
+        return false;
+    char buffer[1 << 14];
+    while (in) {
+        in.read(buffer, sizeof(buffer));
+        m_buffer.append(buffer, static_cast<size_t>(in.gcount()));
+    }
+    m_begin = m_buffer.data();
+    m_end = m_begin + m_buffer.size();
+    return true;
+}
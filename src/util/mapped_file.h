@@ -0,0 +1,46 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    mapped_file.h
+
+Abstract:
+
+    Read-only view of a file's contents. 
+    The file is memory mapped where the platform supports it.
+    Input that cannot be mapped, such as pipes, is optionally read
+    into a buffer. Otherwise the view is not open and clients
+    stream the file instead.
+
+--*/
+#pragma once
+
+#include <string>
+
+class mapped_file {
+    char const*   m_begin;
+    char const*   m_end;
+    bool          m_open;
+    bool          m_mapped;
+    std::string   m_buffer;   // contents when the file could not be mapped
+#ifdef _WINDOWS
+    void*         m_file;
+    void*         m_mapping;
+#endif
+    bool map(char const* file_name);
+    bool read(char const* file_name);
+public:
+    /**
+       \brief map the file. If it cannot be mapped and read_unmapped is true
+       the file is read into a buffer, otherwise is_open() is false.
+    */
+    mapped_file(char const* file_name, bool read_unmapped);
+    ~mapped_file();
+    mapped_file(mapped_file const&) = delete;
+    mapped_file& operator=(mapped_file const&) = delete;
+    bool is_open() const { return m_open; }
+    char const* begin() const { return m_begin; }
+    char const* end() const { return m_end; }
+    size_t size() const { return m_end - m_begin; }
+};
@@ -7,6 +7,8 @@ Copyright (c) 2015 Microsoft Corporation
 #include<iostream>
 #include<stdlib.h>
 #include<climits>
+#include<cstring>
+#include<algorithm>
 #include "util/mutex.h"
 #include "util/trace.h"
 #include "util/memory_manager.h"
@@ -86,6 +88,11 @@ public:
 mem_usage_report g_info;
 #endif
 
+#if !defined(SINGLE_THREAD) && (defined(_WINDOWS) || defined(_USE_THREAD_LOCAL)) && defined(Z3_THREAD_CACHE_ALLOC)
+static void initialize_thread_cache();
+static void finalize_thread_cache();
+#endif
+
 void memory::initialize(size_t max_size) {
     static mutex init_mux;
     lock_guard lock(init_mux);
@@ -98,6 +105,9 @@ void memory::initialize(size_t max_size) {
         return;
 
     g_memory_out_of_memory = false;
+#if !defined(SINGLE_THREAD) && (defined(_WINDOWS) || defined(_USE_THREAD_LOCAL)) && defined(Z3_THREAD_CACHE_ALLOC)
+    initialize_thread_cache();
+#endif
     mem_initialize();
     g_memory_initialized = true;
 }
@@ -135,6 +145,10 @@ void memory::finalize(bool shutdown) {
     if (g_memory_initialized) {
         g_finalizing = true;
         mem_finalize();
+#if !defined(SINGLE_THREAD) && (defined(_WINDOWS) || defined(_USE_THREAD_LOCAL)) && defined(Z3_THREAD_CACHE_ALLOC)
+        if (shutdown)
+            finalize_thread_cache();
+#endif
         // we leak the mutex since we need it to be always live since memory may
         // be reinitialized again
         //delete g_memory_mux;
@@ -257,12 +271,254 @@ static void synchronize_counters(bool allocating) {
     }
 }
 
+#ifdef Z3_THREAD_CACHE_ALLOC
+// ==================================
+// Thread caching allocator.
+// Blocks of at most MAX_CACHED_SIZE bytes (including the size field) are served from
+// per-thread free lists segregated by size class. A thread refills an empty list with
+// a batch of blocks from a global pool and hands surplus blocks back in batches, so 
+// the global lock and malloc are touched once per batch instead of once per block.
+// Blocks are carved out of slabs that are returned to the system when the memory
+// manager is finalized for shutdown. The free lists of all threads point into the
+// slabs, so finalization empties them first. It must not run concurrently with
+// allocations in other threads.
+// A free block stores the next block of its list in its first word and, while it heads
+// a batch in the global pool, the next batch in its second word.
+// ==================================
+
+#define SIZE_CLASS_SHIFT 4
+#define MAX_CACHED_SIZE  1024
+#define NUM_SIZE_CLASSES (MAX_CACHED_SIZE >> SIZE_CLASS_SHIFT)
+#define CACHE_BATCH_SIZE 64
+#define CACHE_SLAB_SIZE  (1 << 18)
+#define CACHE_SLAB_HEADER 16 // keeps the blocks 16-byte aligned
+
+static DECLARE_INIT_MUTEX(g_pool_mux);
+static void *  g_pool_batches[NUM_SIZE_CLASSES];
+static char *  g_pool_slab_ptr = nullptr;
+static char *  g_pool_slab_end = nullptr;
+static void *  g_pool_slabs = nullptr;    // slabs linked through their first word
+static bool    g_pool_finalized = false;  // slabs were freed, blocks released later are dropped
+
+thread_local void *   g_thread_free[NUM_SIZE_CLASSES];
+thread_local unsigned g_thread_num_free[NUM_SIZE_CLASSES];
+thread_local bool     g_thread_cache_registered = false;
+thread_local bool     g_thread_cache_released = false;
+
+// The free lists of the threads that use the cache, linked under g_pool_mux.
+struct thread_cache_entry {
+    void **              m_free;
+    unsigned *           m_num_free;
+    thread_cache_entry * m_prev;
+    thread_cache_entry * m_next;
+};
+static thread_cache_entry * g_thread_caches = nullptr;
+thread_local thread_cache_entry g_thread_cache_entry;
+
+static inline unsigned size_class(size_t s) { return static_cast<unsigned>((s - 1) >> SIZE_CLASS_SHIFT); }
+static inline size_t class_size(unsigned c) { return static_cast<size_t>(c + 1) << SIZE_CLASS_SHIFT; }
+static inline void *& next_block(void * b) { return static_cast<void**>(b)[0]; }
+static inline void *& next_batch(void * b) { return static_cast<void**>(b)[1]; }
+
+// hand a chain of blocks back to the global pool
+static void release_batch(unsigned c, void * head) {
+    lock_guard lock(*g_pool_mux);
+    next_batch(head) = g_pool_batches[c];
+    g_pool_batches[c] = head;
+}
+
+static void release_thread_cache() {
+    for (unsigned c = 0; c < NUM_SIZE_CLASSES; ++c) {
+        if (g_thread_free[c] && !g_pool_finalized) 
+            release_batch(c, g_thread_free[c]);
+        g_thread_free[c] = nullptr;
+        g_thread_num_free[c] = 0;
+    }
+    g_thread_cache_released = true;
+    if (g_thread_cache_registered) {
+        lock_guard lock(*g_pool_mux);
+        thread_cache_entry & e = g_thread_cache_entry;
+        if (e.m_prev) 
+            e.m_prev->m_next = e.m_next;
+        else 
+            g_thread_caches = e.m_next;
+        if (e.m_next) 
+            e.m_next->m_prev = e.m_prev;
+    }
+}
+
+// Returns the cached blocks of a thread to the global pool when the thread exits.
+struct thread_cache_releaser {
+    ~thread_cache_releaser() { release_thread_cache(); }
+};
+thread_local thread_cache_releaser g_thread_cache_releaser;
+
+// obtain a chain of blocks of class c and return the number of blocks in it.
+static unsigned acquire_batch(unsigned c, void *& head) {
+    lock_guard lock(*g_pool_mux);
+    head = g_pool_batches[c];
+    if (head) {
+        g_pool_batches[c] = next_batch(head);
+        unsigned n = 0;
+        for (void * b = head; b; b = next_block(b)) 
+            ++n;
+        return n;
+    }
+    size_t sz = class_size(c);
+    unsigned n = 0;
+    if (g_pool_slab_ptr + sz * CACHE_BATCH_SIZE > g_pool_slab_end) {
+        // hand out the rest of the current slab as a smaller batch before taking a new one.
+        for (; g_pool_slab_ptr && g_pool_slab_ptr + sz <= g_pool_slab_end; g_pool_slab_ptr += sz, ++n) {
+            next_block(g_pool_slab_ptr) = head;
+            head = g_pool_slab_ptr;
+        }
+        if (n > 0)
+            return n;
+        char * slab = static_cast<char*>(malloc(CACHE_SLAB_SIZE));
+        if (!slab) {
+            g_pool_slab_ptr = g_pool_slab_end = nullptr;
+            return 0;
+        }
+        next_block(slab) = g_pool_slabs;
+        g_pool_slabs = slab;
+        g_pool_slab_ptr = slab + CACHE_SLAB_HEADER;
+        g_pool_slab_end = slab + CACHE_SLAB_SIZE;
+    }
+    for (; n < CACHE_BATCH_SIZE; ++n, g_pool_slab_ptr += sz) {
+        next_block(g_pool_slab_ptr) = head;
+        head = g_pool_slab_ptr;
+    }
+    return n;
+}
+
+// obtain a single block of class c, for threads whose cache was released.
+static void * acquire_block(unsigned c) {
+    void * head = nullptr;
+    acquire_batch(c, head);
+    if (head && next_block(head)) {
+        release_batch(c, next_block(head));
+        next_block(head) = nullptr;
+    }
+    return head;
+}
+
+static void initialize_thread_cache() {
+    lock_guard lock(*g_pool_mux);
+    g_pool_finalized = false;
+}
+
+static void finalize_thread_cache() {
+    lock_guard lock(*g_pool_mux);
+    // empty the free lists of all threads before their blocks are freed.
+    for (thread_cache_entry * e = g_thread_caches; e; e = e->m_next) {
+        for (unsigned c = 0; c < NUM_SIZE_CLASSES; ++c) {
+            e->m_free[c] = nullptr;
+            e->m_num_free[c] = 0;
+        }
+    }
+    while (g_pool_slabs) {
+        void * slab = g_pool_slabs;
+        g_pool_slabs = next_block(slab);
+        free(slab);
+    }
+    for (unsigned c = 0; c < NUM_SIZE_CLASSES; ++c) 
+        g_pool_batches[c] = nullptr;
+    g_pool_slab_ptr = g_pool_slab_end = nullptr;
+    g_pool_finalized = true;
+}
+
+static inline void register_thread_cache() {
+    if (!g_thread_cache_registered) {
+        g_thread_cache_registered = true;
+        // odr-use the releaser so that its destructor runs when the thread exits.
+        (void)&g_thread_cache_releaser;
+        lock_guard lock(*g_pool_mux);
+        thread_cache_entry & e = g_thread_cache_entry;
+        e.m_free = g_thread_free;
+        e.m_num_free = g_thread_num_free;
+        e.m_prev = nullptr;
+        e.m_next = g_thread_caches;
+        if (g_thread_caches) 
+            g_thread_caches->m_prev = &e;
+        g_thread_caches = &e;
+    }
+}
+
+static void * allocate_cached(unsigned c) {
+    if (g_thread_cache_released) {
+        // the thread is shutting down, do not refill its cache
+        return acquire_block(c);
+    }
+    void * r = g_thread_free[c];
+    if (!r) {
+        register_thread_cache();
+        g_thread_num_free[c] = acquire_batch(c, r);
+        if (!r) 
+            return nullptr;
+    }
+    g_thread_free[c] = next_block(r);
+    g_thread_num_free[c]--;
+    return r;
+}
+
+static void deallocate_cached(unsigned c, void * p) {
+    if (g_pool_finalized) 
+        return;
+    if (g_thread_cache_released) {
+        // the thread is shutting down, bypass its cache
+        next_block(p) = nullptr;
+        release_batch(c, p);
+        return;
+    }
+    register_thread_cache();
+    next_block(p) = g_thread_free[c];
+    g_thread_free[c] = p;
+    if (++g_thread_num_free[c] > 2 * CACHE_BATCH_SIZE) {
+        // keep CACHE_BATCH_SIZE blocks and return the rest.
+        void * last = p;
+        for (unsigned i = 1; i < CACHE_BATCH_SIZE; ++i) 
+            last = next_block(last);
+        void * surplus = next_block(last);
+        next_block(last) = nullptr;
+        g_thread_num_free[c] = CACHE_BATCH_SIZE;
+        release_batch(c, surplus);
+    }
+}
+
+static inline void * malloc_block(size_t& s) {
+    if (s <= MAX_CACHED_SIZE) {
+        unsigned c = size_class(s);
+        s = class_size(c);
+        return allocate_cached(c);
+    }
+    return malloc(s);
+}
+
+static inline void free_block(void * p, size_t s) {
+    if (s <= MAX_CACHED_SIZE) 
+        deallocate_cached(size_class(s), p);
+    else
+        free(p);
+}
+
+#else
+
+static inline void * malloc_block(size_t& s) {
+    return malloc(s);
+}
+
+static inline void free_block(void * p, size_t s) {
+    free(p);
+}
+
+#endif
+
 void memory::deallocate(void * p) {
     size_t * sz_p  = reinterpret_cast<size_t*>(p) - 1;
     size_t sz      = *sz_p;
     void * real_p  = reinterpret_cast<void*>(sz_p);
     g_memory_thread_alloc_size -= sz;
-    free(real_p);
+    free_block(real_p, sz);
     if (g_memory_thread_alloc_size < -SYNCH_THRESHOLD) {
         synchronize_counters(false);
     }
@@ -270,7 +526,7 @@ void memory::deallocate(void * p) {
 
 void * memory::allocate(size_t s) {
     s = s + sizeof(size_t); // we allocate an extra field!
-    void * r = malloc(s);
+    void * r = malloc_block(s);
     if (r == 0) {
         throw_out_of_memory();
         return nullptr;
@@ -291,6 +547,16 @@ void* memory::reallocate(void *p, size_t s) {
     void *real_p = reinterpret_cast<void*>(sz_p);
     s = s + sizeof(size_t); // we allocate an extra field!
 
+#ifdef Z3_THREAD_CACHE_ALLOC
+    if (sz <= MAX_CACHED_SIZE || s <= MAX_CACHED_SIZE) {
+        // at least one side lives in the thread cache, move the contents.
+        void * r = allocate(s - sizeof(size_t));
+        memcpy(r, p, std::min(s, sz) - sizeof(size_t));
+        deallocate(p);
+        return r;
+    }
+#endif
+
     g_memory_thread_alloc_size += s - sz;
     g_memory_thread_alloc_count += 1;
     if (g_memory_thread_alloc_size > SYNCH_THRESHOLD) {
@@ -0,0 +1,171 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    packed_key_table.h
+
+Abstract:
+
+    Open addressing hash table for objects identified by a 64-bit key.
+
+    The key of an object is computed by KeyProc, and two objects are
+    considered equal if they have the same key. Cells store the key next
+    to the object pointer, so probing does not dereference the stored
+    objects. Collisions are resolved by linear probing and erase uses
+    backward shift deletion, so the table has no tombstones.
+
+    It is used for congruence tables of unary and binary function
+    applications, where the key packs the ids of the argument roots.
+    erase returns the key of the removed object and insert_if_not_there
+    accepts a key, so that a caller that knows how the key of an object
+    changed can reinsert it without computing the key again.
+
+--*/
+#pragma once
+
+#include "util/vector.h"
+#include "util/hash.h"
+
+template<typename T, typename KeyProc>
+class packed_key_table : private KeyProc {
+    struct cell {
+        uint64_t m_key;
+        T *      m_value; // nullptr if the cell is free
+    };
+
+    svector<cell> m_cells;
+    unsigned      m_size { 0 };
+    unsigned      m_mask { 0 };
+
+    uint64_t get_key(T * n) const { return KeyProc::operator()(n); }
+
+    unsigned get_pos(uint64_t key) const { return hash_ull(key) & m_mask; }
+
+    unsigned find_pos(uint64_t key) const {
+        if (m_cells.empty())
+            return UINT_MAX;
+        unsigned idx = get_pos(key);
+        while (true) {
+            cell const & c = m_cells[idx];
+            if (!c.m_value)
+                return UINT_MAX;
+            if (c.m_key == key)
+                return idx;
+            idx = (idx + 1) & m_mask;
+        }
+    }
+
+    void insert_core(uint64_t key, T * n) {
+        unsigned idx = get_pos(key);
+        while (m_cells[idx].m_value)
+            idx = (idx + 1) & m_mask;
+        m_cells[idx].m_key = key;
+        m_cells[idx].m_value = n;
+    }
+
+    void expand() {
+        svector<cell> old_cells;
+        old_cells.swap(m_cells);
+        unsigned capacity = old_cells.empty() ? 16 : 2 * old_cells.size();
+        m_cells.resize(capacity, cell{ 0, nullptr });
+        m_mask = capacity - 1;
+        for (cell const & c : old_cells)
+            if (c.m_value)
+                insert_core(c.m_key, c.m_value);
+    }
+
+public:
+    packed_key_table(KeyProc const & k = KeyProc()):KeyProc(k) {}
+
+    unsigned size() const { return m_size; }
+
+    bool empty() const { return m_size == 0; }
+
+    void reset() {
+        m_cells.reset();
+        m_size = 0;
+        m_mask = 0;
+    }
+
+    /**
+       \brief Insert n if the table does not contain an object with the
+       same key. Return the object that is in the table afterwards.
+    */
+    T * insert_if_not_there(T * n) {
+        return insert_if_not_there(n, get_key(n));
+    }
+
+    /**
+       \brief Insert n with the given key, which must be the key of n.
+    */
+    T * insert_if_not_there(T * n, uint64_t key) {
+        SASSERT(n);
+        SASSERT(key == get_key(n));
+        unsigned idx = find_pos(key);
+        if (idx != UINT_MAX)
+            return m_cells[idx].m_value;
+        if (2 * (m_size + 1) > m_cells.size())
+            expand();
+        insert_core(key, n);
+        ++m_size;
+        return n;
+    }
+
+    bool find(T * n, T * & r) const {
+        unsigned idx = find_pos(get_key(n));
+        if (idx == UINT_MAX)
+            return false;
+        r = m_cells[idx].m_value;
+        return true;
+    }
+
+    bool contains(T * n) const {
+        return find_pos(get_key(n)) != UINT_MAX;
+    }
+
+    /**
+       \brief Erase the object with the key of n and return the key.
+    */
+    uint64_t erase(T * n) {
+        uint64_t key = get_key(n);
+        unsigned i = find_pos(key);
+        if (i == UINT_MAX)
+            return key;
+        --m_size;
+        // shift back the cells of the probe sequence that follows i.
+        unsigned j = i;
+        while (true) {
+            j = (j + 1) & m_mask;
+            cell & c = m_cells[j];
+            if (!c.m_value)
+                break;
+            unsigned k = get_pos(c.m_key);
+            // keep c if its home position k is cyclically in (i, j]
+            if (i <= j ? (i < k && k <= j) : (i < k || k <= j))
+                continue;
+            m_cells[i] = c;
+            i = j;
+        }
+        m_cells[i].m_value = nullptr;
+        return key;
+    }
+
+    class iterator {
+        cell const * m_curr;
+        cell const * m_end;
+        void move_to_used() {
+            while (m_curr != m_end && !m_curr->m_value)
+                ++m_curr;
+        }
+    public:
+        iterator(cell const * curr, cell const * end):m_curr(curr), m_end(end) { move_to_used(); }
+        T * operator*() const { return m_curr->m_value; }
+        iterator & operator++() { ++m_curr; move_to_used(); return *this; }
+        bool operator==(iterator const & other) const { return m_curr == other.m_curr; }
+        bool operator!=(iterator const & other) const { return m_curr != other.m_curr; }
+    };
+
+    iterator begin() const { return iterator(m_cells.begin(), m_cells.end()); }
+    iterator end() const { return iterator(m_cells.end(), m_cells.end()); }
+};
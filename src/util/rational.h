@@ -105,6 +105,8 @@ public:
     uint64_t get_uint64() const { return m().get_uint64(m_val); }
 
     int64_t get_int64() const { return m().get_int64(m_val); }
+
+    void set_int64(int64_t v) { m().set(m_val, v); }
     
     bool is_unsigned() const { return is_uint64() && (get_uint64() < (1ull << 32ull)); }
 
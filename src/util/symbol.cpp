@@ -50,13 +50,12 @@ public:
         DEALLOC_MUTEX(lock);
     }
 
-    char const * get_str(char const * d) {
+    char const * get_str(char const * d, size_t l) {
         const char * result;
         lock_guard _lock(*lock);
         str_hashtable::entry * e;
         if (m_table.insert_if_not_there_core(d, e)) {
             // new entry
-            size_t l   = strlen(d);
             // store the hash-code before the string
             size_t * mem = static_cast<size_t*>(m_region.allocate(l + 1 + sizeof(size_t)));
             *mem = e->get_hash();
@@ -74,11 +73,22 @@ public:
     }
 };
 
+#if !defined(SINGLE_THREAD) && (defined(_WINDOWS) || defined(_USE_THREAD_LOCAL))
+#define SYMBOL_THREAD_CACHE
+// Direct-mapped cache of recently interned strings. It lets threads that
+// repeatedly intern the same names (e.g., parsers) bypass the table locks.
+// Entries are invalidated wholesale when the symbol tables are re-created.
+#define SYMBOL_CACHE_SIZE 1024
+thread_local char const * g_symbol_cache[SYMBOL_CACHE_SIZE];
+thread_local unsigned     g_symbol_cache_epoch = 0;
+#endif
+
 struct internal_symbol_tables {
     unsigned sz;
     internal_symbol_table** tables;
+    unsigned epoch;
 
-    internal_symbol_tables(unsigned sz): sz(sz), tables(alloc_vect<internal_symbol_table*>(sz)) {
+    internal_symbol_tables(unsigned sz, unsigned epoch): sz(sz), tables(alloc_vect<internal_symbol_table*>(sz)), epoch(epoch) {
         for (unsigned i = 0; i < sz; ++i) {
             tables[i] = alloc(internal_symbol_table);
         }
@@ -91,13 +101,32 @@ struct internal_symbol_tables {
     }
 
     char const * get_str(char const * d) {
-        auto* table = tables[string_hash(d, static_cast<unsigned>(strlen(d)), 251) % sz];
-        return table->get_str(d);
+        size_t l = strlen(d);
+        // same hash code as str_hash_proc, which is stored in front of interned strings.
+        unsigned h = string_hash(d, static_cast<unsigned>(l), 17);
+#ifdef SYMBOL_THREAD_CACHE
+        if (g_symbol_cache_epoch != epoch) {
+            memset(g_symbol_cache, 0, sizeof(g_symbol_cache));
+            g_symbol_cache_epoch = epoch;
+        }
+        char const*& cached = g_symbol_cache[h & (SYMBOL_CACHE_SIZE - 1)];
+        if (cached && reinterpret_cast<size_t const*>(cached)[-1] == h && strcmp(cached, d) == 0)
+            return cached;
+#endif
+        // scramble the hash code for selecting the shard, 
+        // the low bits of h determine the position within the shard.
+        auto* table = tables[((h * 2654435761u) >> 16) % sz];
+        char const* result = table->get_str(d, l);
+#ifdef SYMBOL_THREAD_CACHE
+        cached = result;
+#endif
+        return result;
     }
 };
 
 
 static internal_symbol_tables* g_symbol_tables = nullptr;
+static unsigned g_symbol_tables_epoch = 0;
 
 void initialize_symbols() {
     if (!g_symbol_tables) {
@@ -106,7 +135,7 @@ void initialize_symbols() {
 #else
         unsigned num_tables = 2 * std::min((unsigned) std::thread::hardware_concurrency(), 64u);
 #endif
-        g_symbol_tables = alloc(internal_symbol_tables, num_tables);
+        g_symbol_tables = alloc(internal_symbol_tables, num_tables, ++g_symbol_tables_epoch);
         
     }
 }
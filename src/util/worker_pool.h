@@ -0,0 +1,94 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    worker_pool.h
+
+Abstract:
+
+    Threads that are kept across several parallel steps.
+    run(job) calls job(i) for i = 0 .. size() - 1, job(0) on the calling
+    thread, and returns when all calls are done.
+    In single threaded builds run calls the jobs in order on the calling thread.
+
+--*/
+#pragma once
+
+#include <functional>
+#include "util/vector.h"
+#ifndef SINGLE_THREAD
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+class worker_pool {
+#ifdef SINGLE_THREAD
+    unsigned                      m_size;
+public:
+    worker_pool(unsigned num_threads): m_size(num_threads == 0 ? 1 : num_threads) {}
+    unsigned size() const { return m_size; }
+    void run(std::function<void(unsigned)> const& job) {
+        for (unsigned i = 0; i < m_size; ++i)
+            job(i);
+    }
+#else
+    std::mutex                    m_mux;
+    std::condition_variable       m_start;
+    std::condition_variable       m_done;
+    std::function<void(unsigned)> m_job;
+    unsigned                      m_round { 0 };
+    unsigned                      m_pending { 0 };
+    bool                          m_shutdown { false };
+    vector<std::thread>           m_threads;
+
+    void work(unsigned i) {
+        unsigned round = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m_mux);
+                m_start.wait(lock, [&]() { return m_shutdown || m_round != round; });
+                if (m_shutdown)
+                    return;
+                round = m_round;
+            }
+            m_job(i);
+            std::lock_guard<std::mutex> lock(m_mux);
+            if (--m_pending == 0)
+                m_done.notify_one();
+        }
+    }
+
+public:
+    worker_pool(unsigned num_threads) {
+        for (unsigned i = 1; i < num_threads; ++i)
+            m_threads.push_back(std::thread([this, i]() { work(i); }));
+    }
+
+    ~worker_pool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mux);
+            m_shutdown = true;
+        }
+        m_start.notify_all();
+        for (auto& th : m_threads)
+            th.join();
+    }
+
+    unsigned size() const { return m_threads.size() + 1; }
+
+    void run(std::function<void(unsigned)> const& job) {
+        {
+            std::lock_guard<std::mutex> lock(m_mux);
+            m_job = job;
+            m_pending = m_threads.size();
+            ++m_round;
+        }
+        m_start.notify_all();
+        job(0);
+        std::unique_lock<std::mutex> lock(m_mux);
+        m_done.wait(lock, [&]() { return m_pending == 0; });
+    }
+#endif
+};